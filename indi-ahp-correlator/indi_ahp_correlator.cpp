@@ -25,6 +25,8 @@
 #include <sys/file.h>
 #include <memory>
 #include <regex>
+#include <chrono>
+#include <algorithm>
 #include <indicom.h>
 #include <sys/stat.h>
 
@@ -35,6 +37,9 @@
 #include <connectionplugins/connectionserial.h>
 #include "indi_ahp_correlator.h"
 
+// Upper bound of memory reserved up front for the series of a single integration, all lines and baselines together
+#define AHP_XC_MAX_RESERVED_BYTES (64 * 1024 * 1024)
+
 static int nplots = 1;
 static std::unique_ptr<AHP_XC> array(new AHP_XC());
 
@@ -239,6 +244,64 @@ void AHP_XC::sendFile(IBLOB* Blobs, IBLOBVectorProperty BlobP, int len)
     LOG_INFO( "Upload complete");
 }
 
+void AHP_XC::resetSeries()
+{
+    seriesReset = false;
+
+    bool autocorrelations = ahp_xc_get_autocorrelator_jittersize() > 1;
+    bool crosscorrelations = ahp_xc_get_crosscorrelator_jittersize() > 1;
+
+    // Reserve room for the expected number of packets, within a memory budget shared
+    // by all series; longer integrations still grow geometrically from there.
+    size_t width = 0;
+    if(autocorrelations)
+        for(int x = 0; x < ahp_xc_get_nlines(); x++)
+            width += static_cast<size_t>(autocorrelations_str[x]->sizes[0]);
+    if(crosscorrelations)
+        for(int x = 0; x < ahp_xc_get_nbaselines(); x++)
+            width += static_cast<size_t>(crosscorrelations_str[x]->sizes[0]);
+    size_t rows = static_cast<size_t>(ExposureRequest * 1000000.0 / std::max(static_cast<double>(ahp_xc_get_packettime()), 1.0)) + 1;
+    rows = std::min(rows, static_cast<size_t>(AHP_XC_MAX_RESERVED_BYTES) / (sizeof(dsp_t) * std::max(width, static_cast<size_t>(1))));
+
+    autocorrelations_series.resize(static_cast<size_t>(ahp_xc_get_nlines()));
+    if(autocorrelations) {
+        for(int x = 0; x < ahp_xc_get_nlines(); x++) {
+            autocorrelations_series[x].clear();
+            autocorrelations_series[x].reserve(rows * static_cast<size_t>(autocorrelations_str[x]->sizes[0]));
+        }
+    }
+    crosscorrelations_series.resize(static_cast<size_t>(ahp_xc_get_nbaselines()));
+    if(crosscorrelations) {
+        for(int x = 0; x < ahp_xc_get_nbaselines(); x++) {
+            crosscorrelations_series[x].clear();
+            crosscorrelations_series[x].reserve(rows * static_cast<size_t>(crosscorrelations_str[x]->sizes[0]));
+        }
+    }
+
+    seriesStoreTime[0] = seriesStoreTime[1] = 0;
+    seriesStoreCount[0] = seriesStoreCount[1] = 0;
+}
+
+void AHP_XC::appendSeries(std::vector<dsp_t> &series, int width, const ahp_xc_sample &sample)
+{
+    size_t pos = series.size();
+    series.resize(pos + static_cast<size_t>(width));
+    for(unsigned int i = 0; i < sample.jitter_size && i < static_cast<unsigned int>(width); i++)
+        series[pos + i] = sample.correlations[i].coherence;
+}
+
+void AHP_XC::storeSeries(dsp_stream_p stream, std::vector<dsp_t> &series)
+{
+    int rows = static_cast<int>(series.size() / static_cast<size_t>(stream->sizes[0]));
+    stream->sizes[1] = std::max(rows, 1);
+    stream->len = stream->sizes[0] * stream->sizes[1];
+    dsp_stream_alloc_buffer(stream, stream->len);
+    memset(stream->buf, 0, sizeof(dsp_t) * static_cast<size_t>(stream->len));
+    if(!series.empty())
+        memcpy(stream->buf, series.data(), sizeof(dsp_t) * series.size());
+    series.clear();
+}
+
 void AHP_XC::Callback()
 {
     ahp_xc_packet* packet = ahp_xc_alloc_packet();
@@ -315,6 +378,8 @@ void AHP_XC::Callback()
             }
         }
         if(InExposure) {
+            if(seriesReset)
+                resetSeries();
             timeleft = CalcTimeLeft();
             if(timeleft <= 0.0) {
                 // We're no longer exposing...
@@ -349,6 +414,7 @@ void AHP_XC::Callback()
                 if(ahp_xc_get_nlines() > 0 && ahp_xc_get_autocorrelator_jittersize() > 1) {
                     blobs = static_cast<char**>(realloc(blobs, sizeof(char*)*static_cast<unsigned int>(autocorrelationsBP.nbp)+1));
                     for(int x = 0; x < ahp_xc_get_nlines(); x++) {
+                        storeSeries(autocorrelations_str[x], autocorrelations_series[x]);
                         size_t memsize = static_cast<unsigned int>(autocorrelations_str[x]->len)*sizeof(double);
                         void* fits = dsp_file_write_fits(-64, &memsize, autocorrelations_str[x]);
                         if(fits != nullptr) {
@@ -373,13 +439,14 @@ void AHP_XC::Callback()
                     idx = 0;
                     for(int x = 0; x < ahp_xc_get_nlines(); x++) {
                         for(int y = x+1; y < ahp_xc_get_nlines(); y++) {
-                            size_t memsize = static_cast<unsigned int>(crosscorrelations_str[x]->len)*sizeof(double);
-                            void* fits = dsp_file_write_fits(-64, &memsize, crosscorrelations_str[x]);
+                            storeSeries(crosscorrelations_str[idx], crosscorrelations_series[idx]);
+                            size_t memsize = static_cast<unsigned int>(crosscorrelations_str[idx]->len)*sizeof(double);
+                            void* fits = dsp_file_write_fits(-64, &memsize, crosscorrelations_str[idx]);
                             if(fits != nullptr) {
-                                blobs[x] = static_cast<char*>(malloc(memsize));
-                                memcpy(blobs[x], fits, memsize);
-                                crosscorrelationsB[x].blob = blobs[x];
-                                crosscorrelationsB[x].bloblen = static_cast<int>(memsize);
+                                blobs[idx] = static_cast<char*>(malloc(memsize));
+                                memcpy(blobs[idx], fits, memsize);
+                                crosscorrelationsB[idx].blob = blobs[idx];
+                                crosscorrelationsB[idx].bloblen = static_cast<int>(memsize);
                                 free(fits);
                             }
                             crosscorrelations_str[idx]->sizes[1] = 1;
@@ -395,6 +462,8 @@ void AHP_XC::Callback()
                     }
                 }
                 free(blobs);
+                LOGF_DEBUG("Correlation rows stored in %.2f us per packet during the first half of the integration, %.2f us during the second half",
+                           seriesStoreTime[0] / std::max(seriesStoreCount[0], 1), seriesStoreTime[1] / std::max(seriesStoreCount[1], 1));
                 LOG_INFO("Download complete.");
             } else {
                 // Filling BLOBs
@@ -418,26 +487,19 @@ void AHP_XC::Callback()
                         }
                     }
                 }
+                auto start = std::chrono::steady_clock::now();
                 if(ahp_xc_get_nlines() > 0 && ahp_xc_get_autocorrelator_jittersize() > 1) {
-                    for(int x = 0; x < ahp_xc_get_nlines(); x++) {
-                        int pos = autocorrelations_str[x]->len-autocorrelations_str[x]->sizes[0];
-                        autocorrelations_str[x]->sizes[1]++;
-                        autocorrelations_str[x]->len += autocorrelations_str[x]->sizes[0];
-                        autocorrelations_str[x]->buf = (dsp_t*)realloc(autocorrelations_str[x]->buf, sizeof(dsp_t)*static_cast<unsigned int>(autocorrelations_str[x]->len));
-                        for(unsigned int i = 0; i < packet->autocorrelations[x].jitter_size; i++)
-                            autocorrelations_str[x]->buf[pos++] = packet->autocorrelations[x].correlations[i].coherence;
-                    }
+                    for(int x = 0; x < ahp_xc_get_nlines(); x++)
+                        appendSeries(autocorrelations_series[x], autocorrelations_str[x]->sizes[0], packet->autocorrelations[x]);
                 }
                 if(ahp_xc_get_nbaselines() > 0 && ahp_xc_get_crosscorrelator_jittersize() > 1) {
-                    for(int x = 0; x < ahp_xc_get_nbaselines(); x++) {
-                        int pos = crosscorrelations_str[x]->len-crosscorrelations_str[x]->sizes[0];
-                        crosscorrelations_str[x]->sizes[1]++;
-                        crosscorrelations_str[x]->len += crosscorrelations_str[x]->sizes[0];
-                        crosscorrelations_str[x]->buf = (dsp_t*)realloc(crosscorrelations_str[x]->buf, sizeof(dsp_t)*static_cast<unsigned int>(crosscorrelations_str[x]->len));
-                        for(unsigned int i = 0; i < packet->crosscorrelations[x].jitter_size; i++)
-                            crosscorrelations_str[x]->buf[pos++] = packet->crosscorrelations[x].correlations[i].coherence;
-                    }
+                    for(int x = 0; x < ahp_xc_get_nbaselines(); x++)
+                        appendSeries(crosscorrelations_series[x], crosscorrelations_str[x]->sizes[0], packet->crosscorrelations[x]);
                 }
+                std::chrono::duration<double, std::micro> diff = std::chrono::steady_clock::now() - start;
+                int half = (timeleft > ExposureRequest / 2.0 ? 0 : 1);
+                seriesStoreTime[half] += diff.count();
+                seriesStoreCount[half]++;
             }
         }
 
@@ -691,6 +753,7 @@ bool AHP_XC::StartExposure(float duration)
     ExposureRequest = static_cast<double>(duration);
     PrimaryCCD.setExposureDuration(ExposureRequest);
     gettimeofday(&ExpStart, nullptr);
+    seriesReset = true;
     InExposure = true;
     // We're done
     return true;
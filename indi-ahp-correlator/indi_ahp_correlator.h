@@ -23,6 +23,8 @@
 #include "indiccd.h"
 #include "indicorrelator.h"
 #include <ahp/ahp_xc.h>
+#include <atomic>
+#include <vector>
 
 class baseline : public INDI::Correlator
 {
@@ -174,6 +176,13 @@ private:
     dsp_stream_p *crosscorrelations_str;
     dsp_stream_p *plot_str;
 
+    // Correlation rows collected packet by packet, copied into the dsp streams at download time
+    std::vector<std::vector<dsp_t>> autocorrelations_series;
+    std::vector<std::vector<dsp_t>> crosscorrelations_series;
+    std::atomic_bool seriesReset {false};
+    double seriesStoreTime[2];
+    int seriesStoreCount[2];
+
     INumber settingsN[3];
     INumberVectorProperty settingsNP;
 
@@ -183,6 +192,9 @@ private:
     double timeleft;
     double wavelength;
     void Callback();
+    void resetSeries();
+    void appendSeries(std::vector<dsp_t> &series, int width, const ahp_xc_sample &sample);
+    void storeSeries(dsp_stream_p stream, std::vector<dsp_t> &series);
     bool callHandshake();
     // Utility functions
     double CalcTimeLeft();
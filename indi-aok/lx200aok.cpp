@@ -416,11 +416,16 @@ bool LX200Skywalker::Disconnect()
 
 /**************************************************************************************
 **
-***************************************************************************************
+***************************************************************************************/
 bool LX200Skywalker::ReadScopeStatus()
 {
+    // A new poll cycle: the status records are read again when first needed
+    if (statusQueries > 0)
+        LOGF_DEBUG("%u JSON status queries in last poll cycle", statusQueries);
+    statusQueries = 0;
+    invalidateStatus();
     return (LX200Telescope::ReadScopeStatus());  // TCS does not :D#! -> ovverride isSlewComplete
-}*/
+}
 
 bool LX200Skywalker::isSlewComplete()
 {
@@ -640,11 +645,9 @@ bool LX200Skywalker::SavePark()
 // the model itself!
 bool LX200Skywalker::notifyPierSide()
 {
-    char lstat[20] = {0};
-    if (getJSONData_Y(5, lstat, 20)) // this is the model!
+    if (getStatusY()) // this is the model!
     {
-        int li = std::stoi(lstat);
-        li = li & (1 << 7);
+        int li = yStatus.model & (1 << 7);
         if (li > 0)
             Telescope::setPierSide(INDI::Telescope::PIER_WEST);
         else
@@ -728,6 +731,9 @@ bool LX200Skywalker::sendQuery(const char* cmd, char* response, char end, int wa
     char lresponse[TCS_RESPONSE_BUFFER_LENGTH];
     lresponse [0] = '\0';
     bool lresult = false;
+    // Anything but a plain query may change what the status records report
+    if (cmd[0] != '?' && strncmp(cmd, ":G", 2) != 0)
+        invalidateStatus();
     if(!transmit(cmd))
     {
         LOGF_ERROR("Command <%s> not transmitted.", cmd);
@@ -788,80 +794,100 @@ bool LX200Skywalker::setSiteLatitude(double Lat)
 
 }
 
-bool LX200Skywalker::getJSONData_gp(int jindex, char *jstr, int jstrlen) // preliminary hardcoded  :gp-query
+/**
+ * @brief Fetch the :gp status record unless it was already read in this poll cycle.
+ * @return true iff gpStatus holds valid data
+ */
+bool LX200Skywalker::getStatusGP()
 {
+    if (gpStatus.valid)
+        return true;
+
     char lresponse[128];
     lresponse [0] = '\0';
-    char lcmd[4] = ":gp";
-    char end = '}';
+    const char *lcmd = ":gp";
+    statusQueries++;
     if(!transmit(lcmd))
     {
         LOGF_ERROR("Command <%s> not transmitted.", lcmd);
+        return false;
     }
-    if (receive(lresponse, end, 1))
-    {
-        flush();
-    }
-    else
+    if (!receive(lresponse, '}', 1))
     {
         LOG_ERROR("Failed to get JSONData");
         return false;
     }
-    char data[3][40] = {"", "", ""};
-    int returnCode = sscanf(lresponse, "%*[^[][%40[^\"]%40[^,]%*[,]%40[^]]", data[0], data[1], data[2]);
+    flush();
+
+    GPStatus status;
+    char locked[40] = "";
+    int returnCode = sscanf(lresponse, "%*[^[][%39[^\"]%39[^,]%*[,]%39[^]]", status.id, status.firmware, locked);
     if (returnCode < 1)
     {
         LOGF_ERROR("Failed to parse JSONData '%s'.", lresponse);
         return false;
     }
-    strncpy(jstr, data[jindex], jstrlen);
+    status.locked = atoi(locked);
+    status.valid  = true;
+    gpStatus = status;
     return true;
 }
 
-bool LX200Skywalker::getJSONData_Y(int jindex, char *jstr, int jstrlen) // preliminary hardcoded query :Y#-query
+/**
+ * @brief Fetch the :Y# status record unless it was already read in this poll cycle.
+ * @return true iff yStatus holds valid data
+ */
+bool LX200Skywalker::getStatusY()
 {
+    if (yStatus.valid)
+        return true;
+
     char lresponse[128];
     lresponse [0] = '\0';
-    char lcmd[4] = ":Y#";
-    char end = '}';
+    const char *lcmd = ":Y#";
+    statusQueries++;
     if(!transmit(lcmd))
     {
         LOGF_ERROR("Command <%s> not transmitted.", lcmd);
+        return false;
     }
-    if (receive(lresponse, end, 1))
-    {
-        flush();
-    }
-    else
+    if (!receive(lresponse, '}', 1))
     {
         LOG_ERROR("Failed to get JSONData");
         return false;
     }
-    char data[6][20] = {"", "", "", "", "", ""};
-    int returnCode = sscanf(lresponse, "%20[^,]%*[,]%20[^,]%*[,]%20[^#]%*[#\",]%20[^,]%*[,]%20[^,]%*[,]%20[^,]", data[0],
-                            data[1], data[2], data[3], data[4], data[5]);
+    flush();
+
+    YStatus status;
+    int returnCode = sscanf(lresponse, "%19[^,]%*[,]%19[^,]%*[,]%19[^#]%*[#\",]%19[^,]%*[,]%19[^,]%*[,]%19[^,]",
+                            status.fields[0], status.fields[1], status.fields[2], status.fields[3], status.fields[4],
+                            status.fields[5]);
     if (returnCode < 1)
     {
         LOGF_ERROR("Failed to parse JSONData '%s'.", lresponse);
         return false;
     }
-    strncpy(jstr, data[jindex], jstrlen);
+    status.model = atoi(status.fields[5]);
+    status.valid = true;
+    yStatus = status;
     return true;
 }
 
+/**
+ * @brief Forget the status records, the next caller reads them fresh from the TCS.
+ */
+void LX200Skywalker::invalidateStatus()
+{
+    gpStatus.valid = false;
+    yStatus.valid  = false;
+}
+
 bool LX200Skywalker::MountLocked()
 {
-    char lstat[20] = {0};
-    if(!getJSONData_gp(2, lstat, 20))
+    if(!getStatusGP())
         return false;
     else
-    {
-        int li = std::stoi(lstat);
-        if (li > 0)
-            return true;
-        else
-            return false;
-    }
+        return gpStatus.locked > 0;
 }
 
 bool LX200Skywalker::SetMountLock(bool enable)
@@ -1025,12 +1051,11 @@ bool LX200Skywalker::setSystemSlewSpeed (int xx)
  */
 bool LX200Skywalker::getFirmwareInfo(char* vstring)
 {
-    char lstat[40] = {0};
-    if(!getJSONData_gp(1, lstat, 40))
+    if(!getStatusGP())
         return false;
     else
     {
-        strcpy(vstring, lstat);
+        strcpy(vstring, gpStatus.firmware);
         return true;
     }
 }
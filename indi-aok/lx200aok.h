@@ -29,6 +29,7 @@
 #include <indilogger.h>
 #include <termios.h>
 
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <unistd.h>
@@ -115,12 +116,30 @@ class LX200Skywalker : public LX200Telescope
 
         int controller_format { LX200_LONG_FORMAT };
 
+        // JSON status records of the TCS. Each one is fetched with a single query
+        // when first needed and shared by all callers until the next poll or command.
+        struct GPStatus
+        {
+            bool valid {false};
+            char id[40] {};
+            char firmware[40] {};   // quoted
+            int locked {0};
+        } gpStatus;
+        struct YStatus
+        {
+            bool valid {false};
+            char fields[6][20] {};
+            int model {0};          // fields[5], bit 7 set if pointing east
+        } yStatus;
+        uint32_t statusQueries {0}; // JSON queries sent since the last poll
+
         // override
         virtual void getBasicData() override;
         virtual bool saveConfigItems(FILE *fp) override;
         virtual bool Goto(double ra, double dec) override;
         virtual bool Connect() override;
         virtual bool Disconnect() override;
+        virtual bool ReadScopeStatus() override;
 
         // override INDI::Telescope
         bool Park() override;
@@ -133,8 +152,9 @@ class LX200Skywalker : public LX200Telescope
         bool SavePark();
         bool getSystemSlewSpeed (int *xx);
         bool setSystemSlewSpeed (int xx);
-        bool getJSONData_Y(int jindex, char *jstr, int jstrlen);
-        bool getJSONData_gp(int jindex, char *jstr, int jstrlen);
+        bool getStatusGP();
+        bool getStatusY();
+        void invalidateStatus();
         bool notifyPierSide();
         void notifyMountLock(bool locked);
         void notifyTrackState(INDI::Telescope::TelescopeStatus state);
@@ -77,6 +77,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301  USA
 #define NFLUSHES                1    /* Number of times a CCD array is flushed before an exposure */
 #define TEMP_UPDATE_THRESHOLD   0.05
 #define COOLER_UPDATE_THRESHOLD 0.05
+#define DISCOVERY_QUIET_MSEC    2000 /* Stop network discovery when no device answered for this long */
 
 static std::unique_ptr<ApogeeCCD> apogeeCCD(new ApogeeCCD());
 
@@ -1008,6 +1009,7 @@ bool ApogeeCCD::Connect()
     {
         ioInterface = std::string("ethernet");
         FindDeviceEthernet look4cam;
+        look4cam.SetQuietPeriod(DISCOVERY_QUIET_MSEC);
         char ip[32];
         int port;
 
@@ -1025,7 +1027,7 @@ bool ApogeeCCD::Connect()
         {
             try
             {
-                msg = look4cam.Find(subnet);
+                msg = look4cam.FindCached(subnet);
                 // This can cause a crash
                 //LOGF_DEBUG("Network search result: %s", msg.c_str());
             }
@@ -1107,6 +1109,8 @@ bool ApogeeCCD::Connect()
 
     if (cameraFound == false)
     {
+        // Search the network again next time, the camera may have just been powered on
+        FindDeviceEthernet::ClearCache();
         LOG_ERROR("Unable to find Apogee camera attached. Please check connection and power and try again.");
         return false;
     }
@@ -1163,6 +1167,8 @@ bool ApogeeCCD::Connect()
     }
     catch (std::runtime_error &err)
     {
+        // The cached address may be stale, search the network again next time
+        FindDeviceEthernet::ClearCache();
         LOGF_ERROR("Error opening camera: %s", err.what());
         return false;
     }
@@ -1199,6 +1205,7 @@ bool ApogeeCCD::Connect()
     }
     catch (std::runtime_error &err)
     {
+        FindDeviceEthernet::ClearCache();
         LOGF_ERROR("Error opening CFW: %s", err.what());
         return false;
     }
@@ -1599,6 +1606,7 @@ bool ApogeeCCD::connectCFW()
     {
         ioInterface = std::string("ethernet");
         FindDeviceEthernet look4Filter;
+        look4Filter.SetQuietPeriod(DISCOVERY_QUIET_MSEC);
         char ip[32];
         int port;
 
@@ -1612,7 +1620,7 @@ bool ApogeeCCD::connectCFW()
         {
             try
             {
-                msg = look4Filter.Find(subnet);
+                msg = look4Filter.FindCached(subnet);
                 // FIXME this can cause a crash
                 //LOGF_DEBUG("Network search result: %s", msg.c_str());
             }
@@ -1672,6 +1680,7 @@ bool ApogeeCCD::connectCFW()
 
     if (cfwFound == false)
     {
+        FindDeviceEthernet::ClearCache();
         LOG_ERROR("Unable to find Apogee Filter Wheels attached. Please check connection and power and try again.");
         return false;
     }
@@ -1694,6 +1703,7 @@ bool ApogeeCCD::connectCFW()
     }
     catch (std::runtime_error &err)
     {
+        FindDeviceEthernet::ClearCache();
         LOGF_ERROR("Error opening CFW: %s", err.what());
         return false;
     }
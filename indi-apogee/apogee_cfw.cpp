@@ -28,6 +28,8 @@
 #include "config.h"
 #include "apogee_cfw.h"
 
+#define DISCOVERY_QUIET_MSEC 2000 /* Stop network discovery when no device answered for this long */
+
 static std::unique_ptr<ApogeeCFW> apogeeCFW(new ApogeeCFW());
 
 void ISGetProperties(const char *dev)
@@ -345,6 +347,7 @@ bool ApogeeCFW::Connect()
     {
         ioInterface = std::string("ethernet");
         FindDeviceEthernet look4Filter;
+        look4Filter.SetQuietPeriod(DISCOVERY_QUIET_MSEC);
         char ip[32];
         int port;
 
@@ -358,7 +361,7 @@ bool ApogeeCFW::Connect()
         {
             try
             {
-                msg = look4Filter.Find(subnet);
+                msg = look4Filter.FindCached(subnet);
                 // FIXME this can cause a crash
                 //LOGF_DEBUG("Network search result: %s", msg.c_str());
             }
@@ -418,6 +421,8 @@ bool ApogeeCFW::Connect()
 
     if (filterFound == false)
     {
+        // Search the network again next time, the filter wheel may have just been powered on
+        FindDeviceEthernet::ClearCache();
         LOG_ERROR("Unable to find Apogee Filter Wheels attached. Please check connection and power and try again.");
         return false;
     }
@@ -24,11 +24,13 @@
 #include "indicom.h"
 #include "connectionplugins/connectiontcp.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <cassert>
 #include <memory>
-#include <regex>
 
 #include <termios.h>
 #include <unistd.h>
@@ -420,30 +422,45 @@ void DragonFlyDome::TimerHit()
     if (!isConnected())
         return;
 
-    // Update all sensors
-    m_UpdateSensorCounter++;
-    if (m_UpdateSensorCounter >= SENSOR_UPDATE_THRESHOLD)
+    bool inMotion = (getDomeState() == DOME_MOVING || getDomeState() == DOME_PARKING || getDomeState() == DOME_UNPARKING);
+
+    // While the roof is moving, only the limit sensors are read, on every (fast) timer hit.
+    // At rest, all sensors are read every SENSOR_UPDATE_THRESHOLD timer hit.
+    if (inMotion)
     {
-        m_UpdateSensorCounter = 0;
-        if (updateSensors())
+        if (updateLimitSensors())
             IDSetNumber(&SensorNP, nullptr);
     }
-
-    // Update all relays every RELAY_UPDATE_THRESHOLD timer hit
-    m_UpdateRelayCounter++;
-    if (m_UpdateRelayCounter >= RELAY_UPDATE_THRESHOLD)
+    else
     {
-        m_UpdateRelayCounter = 0;
-        if (updateRelays())
+        m_UpdateSensorCounter++;
+        if (m_UpdateSensorCounter >= SENSOR_UPDATE_THRESHOLD)
         {
-            for (const auto &oneRelay : Relays)
-                oneRelay->sync(oneRelay->isEnabled() ? IPS_OK : IPS_IDLE);
+            m_UpdateSensorCounter = 0;
+            if (updateSensors())
+                IDSetNumber(&SensorNP, nullptr);
+        }
+
+        // Update all relays every RELAY_UPDATE_THRESHOLD timer hit
+        m_UpdateRelayCounter++;
+        if (m_UpdateRelayCounter >= RELAY_UPDATE_THRESHOLD)
+        {
+            m_UpdateRelayCounter = 0;
+            if (updateRelays())
+            {
+                for (const auto &oneRelay : Relays)
+                    oneRelay->sync(oneRelay->isEnabled() ? IPS_OK : IPS_IDLE);
+            }
         }
     }
 
     // If we are in motion
-    if (getDomeState() == DOME_MOVING || getDomeState() == DOME_PARKING || getDomeState() == DOME_UNPARKING)
+    if (inMotion)
     {
+        // The limit changed after the previous read of this move, or after the move started
+        double latency = std::chrono::duration<double, std::milli>(m_LastLimitRead - m_PreviousLimitRead).count();
+        double travel  = std::chrono::duration<double>(m_LastLimitRead - m_MoveStart).count();
+
         // Roll off is opening
         if (DomeMotionS[DOME_CW].s == ISS_ON)
         {
@@ -451,6 +468,7 @@ void DragonFlyDome::TimerHit()
             {
                 setRoofOpen(false);
                 SetParked(false);
+                LOGF_INFO("Roof open limit detected %.1f s after the move started, within %.f ms of sensor change.", travel, latency);
             }
         }
         // Roll Off is closing
@@ -460,11 +478,13 @@ void DragonFlyDome::TimerHit()
             {
                 setRoofClose(false);
                 SetParked(true);
+                LOGF_INFO("Roof closed limit detected %.1f s after the move started, within %.f ms of sensor change.", travel, latency);
             }
         }
     }
 
-    SetTimer(getCurrentPollingPeriod());
+    inMotion = (getDomeState() == DOME_MOVING || getDomeState() == DOME_PARKING || getDomeState() == DOME_UNPARKING);
+    SetTimer(inMotion ? std::min<uint32_t>(MOTION_POLLING_PERIOD, getCurrentPollingPeriod()) : getCurrentPollingPeriod());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -584,6 +604,8 @@ IPState DragonFlyDome::Move(DomeDirection dir, DomeMotionCommand operation)
         else
             setRoofClose(true);
 
+        // Limit reads before the relay was switched do not bound the detection of this move
+        m_MoveStart = m_PreviousLimitRead = m_LastLimitRead = std::chrono::steady_clock::now();
         return IPS_BUSY;
     }
 
@@ -644,6 +666,20 @@ bool DragonFlyDome::isSensorOn(uint8_t id)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+/// Read one sensor
+/////////////////////////////////////////////////////////////////////////////
+bool DragonFlyDome::readSensor(uint8_t id)
+{
+    char cmd[DRIVER_LEN] = {0};
+    int32_t res = 0;
+    snprintf(cmd, DRIVER_LEN, "!relio snanrd 0 %d#", id);
+    if (!sendCommand(cmd, res))
+        return false;
+    SensorN[id].value = res;
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /// Update All Sensors
 /////////////////////////////////////////////////////////////////////////////
@@ -651,17 +687,31 @@ bool DragonFlyDome::updateSensors()
 {
     for (uint8_t i = 0; i < 8; i++)
     {
-        char cmd[DRIVER_LEN] = {0};
-        int32_t res = 0;
-        snprintf(cmd, DRIVER_LEN, "!relio snanrd 0 %d#", i);
-        if (!sendCommand(cmd, res))
+        if (!readSensor(i))
             return false;
-        SensorN[i].value = res;
     }
 
     return true;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Update Roof Limit Sensors only
+/////////////////////////////////////////////////////////////////////////////
+bool DragonFlyDome::updateLimitSensors()
+{
+    int unparked = DomeControlSensorN[SENSOR_UNPARKED].value - 1;
+    int parked = DomeControlSensorN[SENSOR_PARKED].value - 1;
+
+    if (unparked >= 0 && !readSensor(unparked))
+        return false;
+    if (parked >= 0 && parked != unparked && !readSensor(parked))
+        return false;
+
+    m_PreviousLimitRead = m_LastLimitRead;
+    m_LastLimitRead = std::chrono::steady_clock::now();
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 /// Update All Relays
 /////////////////////////////////////////////////////////////////////////////
@@ -716,14 +766,11 @@ bool DragonFlyDome::sendCommand(const char * cmd, int32_t &res)
         response[nbytes_read - 1] = 0;
         LOGF_DEBUG("RES <%s>", response);
 
-
-        std::regex rgx(R"(.*:(\d+))");
-        std::smatch match;
-        std::string input(response);
-
-        if (std::regex_search(input, match, rgx))
+        // Response value follows the last colon, e.g. "!relio snanrd 0 1:512"
+        const char *value = strrchr(response, ':');
+        if (value != nullptr && isdigit(static_cast<unsigned char>(value[1])))
         {
-            res = std::stoi(match.str(1));
+            res = static_cast<int32_t>(strtol(value + 1, nullptr, 10));
             return true;
         }
     }
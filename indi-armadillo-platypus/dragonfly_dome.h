@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <indidome.h>
 
@@ -102,7 +103,9 @@ class DragonFlyDome : public INDI::Dome
         /// Sensors
         ///////////////////////////////////////////////////////////////////////////////
         bool isSensorOn(uint8_t id);
+        bool readSensor(uint8_t id);
         bool updateSensors();
+        bool updateLimitSensors();
 
         ///////////////////////////////////////////////////////////////////////////////
         /// Communication Functions
@@ -153,6 +156,11 @@ class DragonFlyDome : public INDI::Dome
         ///////////////////////////////////////////////////////////////////////
         uint32_t m_UpdateRelayCounter {0};
         uint32_t m_UpdateSensorCounter {0};
+        // Completion time of the last two limit sensor reads of the current move, their difference bounds the detection latency
+        std::chrono::steady_clock::time_point m_LastLimitRead;
+        std::chrono::steady_clock::time_point m_PreviousLimitRead;
+        // Time the current move was commanded
+        std::chrono::steady_clock::time_point m_MoveStart;
 
         /////////////////////////////////////////////////////////////////////////////
         /// Static Helper Values
@@ -175,5 +183,7 @@ class DragonFlyDome : public INDI::Dome
         static constexpr const uint8_t SENSOR_UPDATE_THRESHOLD {2};
         // Relay Update Threshold
         static constexpr const uint8_t RELAY_UPDATE_THRESHOLD {5};
+        // Limit sensors polling period in milliseconds while the roof is moving
+        static constexpr const uint32_t MOTION_POLLING_PERIOD {100};
 
 };
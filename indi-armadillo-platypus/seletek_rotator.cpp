@@ -24,10 +24,11 @@
 #include "indicom.h"
 #include "connectionplugins/connectionserial.h"
 
+#include <algorithm>
+#include <cctype>
 #include <cmath>
 #include <cstring>
 #include <memory>
-#include <regex>
 
 #include <termios.h>
 #include <unistd.h>
@@ -423,6 +424,16 @@ bool SeletekRotator::gotoTarget(uint32_t position)
     else
         m_IsMoving = false;
 
+    if (m_IsMoving)
+    {
+        m_MoveStart = m_LastRead = m_PreviousRead = m_FinalPositionRead = std::chrono::steady_clock::now();
+        m_LastReadPosition = RotatorAbsPosN[0].value;
+        m_TargetPosition = position;
+        m_StepRate = commandedStepRate();
+        m_HasMoved = false;
+        m_PositionReads = 0;
+    }
+
     return m_IsMoving;
 }
 
@@ -514,26 +525,34 @@ void SeletekRotator::TimerHit()
     if (!isConnected())
         return;
 
-    uint32_t res {0};
+    auto now = std::chrono::steady_clock::now();
 
-    if (getParam("getpos", res))
-    {
-        if (fabs(res - RotatorAbsPosN[0].value) > 0)
-        {
-            RotatorAbsPosN[0].value = res;
-            IDSetNumber(&RotatorAbsPosNP, nullptr);
-        }
-        else
-            m_IsMoving = false;
+    // While moving, the controller is read at the polling period and on every
+    // timer hit once the target is near. In between, the position is estimated.
+    bool readController = !m_IsMoving ||
+                          timeToTarget(now) <= NEAR_TARGET_TIME ||
+                          now - m_LastRead >= std::chrono::milliseconds(getCurrentPollingPeriod());
 
-        double newPosition = calculateAngle(res);
+    if (readController)
+    {
+        uint32_t res {0};
 
-        if (fabs(GotoRotatorN[0].value - newPosition) > 0)
+        if (getParam("getpos", res))
         {
-            GotoRotatorN[0].value = newPosition;
-            IDSetNumber(&GotoRotatorNP, nullptr);
+            now = std::chrono::steady_clock::now();
+            if (m_IsMoving && updateMotion(res, now))
+            {
+                m_IsMoving = false;
+                LOGF_DEBUG("Rotator stop reported %.f-%.f ms after it stopped, %u position reads.",
+                           std::chrono::duration<double, std::milli>(now - m_FinalPositionRead).count(),
+                           std::chrono::duration<double, std::milli>(now - m_PreviousRead).count(),
+                           m_PositionReads);
+            }
+            setPosition(res);
         }
     }
+    else
+        setPosition(estimatePosition(now));
 
     if (m_IsMoving == false && (GotoRotatorNP.s == IPS_BUSY || RotatorAbsPosNP.s == IPS_BUSY))
     {
@@ -550,7 +569,105 @@ void SeletekRotator::TimerHit()
         }
     }
 
-    SetTimer(getCurrentPollingPeriod());
+    SetTimer(m_IsMoving ? MOVE_TIMER_PERIOD : getCurrentPollingPeriod());
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Publish position in steps and degrees
+///////////////////////////////////////////////////////////////////////////
+void SeletekRotator::setPosition(uint32_t steps)
+{
+    if (fabs(steps - RotatorAbsPosN[0].value) > 0)
+    {
+        RotatorAbsPosN[0].value = steps;
+        IDSetNumber(&RotatorAbsPosNP, nullptr);
+    }
+
+    double newPosition = calculateAngle(steps);
+
+    if (fabs(GotoRotatorN[0].value - newPosition) > 0)
+    {
+        GotoRotatorN[0].value = newPosition;
+        IDSetNumber(&GotoRotatorNP, nullptr);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Steps per second at the configured maximum speed
+///////////////////////////////////////////////////////////////////////////
+double SeletekRotator::commandedStepRate()
+{
+    // Same conversion as setSpeedRange
+    double usec = 500000 - (SettingN[PARAM_MAX_SPEED].value - 1) * 50;
+    return 1e6 / std::max(usec, 50.0);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Position expected now from the last read position and the step rate
+///////////////////////////////////////////////////////////////////////////
+uint32_t SeletekRotator::estimatePosition(std::chrono::steady_clock::time_point now)
+{
+    double elapsed = std::chrono::duration<double>(now - m_LastRead).count();
+    double remaining = fabs(static_cast<double>(m_TargetPosition) - m_LastReadPosition);
+    double travel = std::min(m_StepRate * elapsed, remaining);
+
+    return m_TargetPosition >= m_LastReadPosition ? m_LastReadPosition + travel : m_LastReadPosition - travel;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Seconds until the target is reached at the current step rate
+///////////////////////////////////////////////////////////////////////////
+double SeletekRotator::timeToTarget(std::chrono::steady_clock::time_point now)
+{
+    if (m_StepRate <= 0)
+        return 0;
+
+    return fabs(static_cast<double>(m_TargetPosition) - estimatePosition(now)) / m_StepRate;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// Track a position read while moving, returns true once the rotator stopped
+///////////////////////////////////////////////////////////////////////////
+bool SeletekRotator::updateMotion(uint32_t position, std::chrono::steady_clock::time_point now)
+{
+    bool changed = position != m_LastReadPosition;
+    m_PositionReads++;
+
+    if (changed)
+    {
+        double elapsed = std::chrono::duration<double>(now - m_LastRead).count();
+        if (elapsed > 0)
+        {
+            // The first interval includes the motor start, later ones are averaged
+            double rate = fabs(static_cast<double>(position) - m_LastReadPosition) / elapsed;
+            m_StepRate = m_HasMoved ? 0.5 * (m_StepRate + rate) : rate;
+        }
+        m_HasMoved = true;
+
+        // The rotator stops somewhere between these two reads
+        m_PreviousRead = m_LastRead;
+        m_FinalPositionRead = now;
+    }
+
+    m_LastRead = now;
+    m_LastReadPosition = position;
+
+    // With backlash, the target is passed before it is approached again
+    bool backlash = IUFindOnSwitchIndex(&RotatorBacklashSP) == INDI_ENABLED && RotatorBacklashN[0].value > 0;
+    if (!backlash && position == m_TargetPosition)
+        return true;
+
+    if (changed)
+        return false;
+
+    // The motor never started
+    if (!m_HasMoved)
+        return now - m_MoveStart >= std::chrono::milliseconds(getCurrentPollingPeriod());
+
+    // Slow steps leave the position unchanged over several reads, so it only
+    // means stopped once it lasted longer than a step period
+    double stepPeriod = m_StepRate > 0 ? 1.0 / m_StepRate : 0;
+    return std::chrono::duration<double>(now - m_FinalPositionRead).count() > stepPeriod + STOP_MARGIN;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -565,6 +682,9 @@ bool SeletekRotator::AbortRotator()
     if (sendCommand(cmd, res))
         rc = (res == 0);
 
+    if (rc)
+        m_IsMoving = false;
+
     if (rc && RotatorAbsPosNP.s == IPS_BUSY)
     {
         RotatorAbsPosNP.s = IPS_IDLE;
@@ -632,7 +752,8 @@ bool SeletekRotator::sendCommand(const char * cmd, int32_t &res)
 
         if (rc != TTY_OK)
         {
-            usleep(100000);
+            // The read already waited for the timeout, drop any partial reply and resend
+            tcflush(PortFD, TCIFLUSH);
             continue;
         }
 
@@ -640,14 +761,11 @@ bool SeletekRotator::sendCommand(const char * cmd, int32_t &res)
         response[nbytes_read - 1] = 0;
         LOGF_DEBUG("RES <%s>", response);
 
-
-        std::regex rgx(R"(.*:(\d+))");
-        std::smatch match;
-        std::string input(response);
-
-        if (std::regex_search(input, match, rgx))
+        // Response value follows the last colon, e.g. "!step getpos 0:1234"
+        const char *value = strrchr(response, ':');
+        if (value != nullptr && isdigit(static_cast<unsigned char>(value[1])))
         {
-            res = std::stoi(match.str(1));
+            res = static_cast<int32_t>(strtol(value + 1, nullptr, 10));
             return true;
         }
     }
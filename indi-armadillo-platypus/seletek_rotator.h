@@ -23,6 +23,8 @@
 
 #include <indirotator.h>
 
+#include <chrono>
+
 class SeletekRotator : public INDI::Rotator
 {
     public:
@@ -61,6 +63,15 @@ class SeletekRotator : public INDI::Rotator
         bool syncSettings();
         bool echo();
         double calculateAngle(uint32_t steps);
+        void setPosition(uint32_t steps);
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// Motion Estimation
+        ///////////////////////////////////////////////////////////////////////////////
+        double commandedStepRate();
+        uint32_t estimatePosition(std::chrono::steady_clock::time_point now);
+        double timeToTarget(std::chrono::steady_clock::time_point now);
+        bool updateMotion(uint32_t position, std::chrono::steady_clock::time_point now);
 
         ///////////////////////////////////////////////////////////////////////////////
         /// Communication Functions
@@ -110,6 +121,19 @@ class SeletekRotator : public INDI::Rotator
         bool m_IsMoving {false};
         uint32_t m_ZeroPosition {0};
 
+        // Between controller reads, the position of a moving rotator is
+        // estimated from the last read position and the step rate.
+        std::chrono::steady_clock::time_point m_MoveStart;
+        std::chrono::steady_clock::time_point m_LastRead;
+        std::chrono::steady_clock::time_point m_PreviousRead;
+        std::chrono::steady_clock::time_point m_FinalPositionRead;
+        uint32_t m_LastReadPosition {0};
+        uint32_t m_TargetPosition {0};
+        // Steps per second, measured while moving
+        double m_StepRate {0};
+        bool m_HasMoved {false};
+        uint32_t m_PositionReads {0};
+
         /////////////////////////////////////////////////////////////////////////////
         /// Static Helper Values
         /////////////////////////////////////////////////////////////////////////////
@@ -124,5 +148,11 @@ class SeletekRotator : public INDI::Rotator
         static constexpr const uint8_t DRIVER_OPERATIVES {2};
         // Models
         static constexpr const uint8_t DRIVER_MODELS {4};
+        // Timer period in ms while moving, for the estimated position
+        static constexpr const uint32_t MOVE_TIMER_PERIOD {100};
+        // Read the controller on every timer hit when the target is this close in seconds
+        static constexpr const double NEAR_TARGET_TIME {1.0};
+        // Time in seconds an unchanged position must last beyond one step period to mean stopped
+        static constexpr const double STOP_MARGIN {0.2};
 
 };
@@ -29,6 +29,7 @@
 #include <indielapsedtimer.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <vector>
 #include <map>
@@ -38,8 +39,13 @@
 #define VERBOSE_EXPOSURE        3
 #define TEMP_TIMER_MS           1000 /* Temperature polling time (ms) */
 #define TEMP_THRESHOLD          .25  /* Differential temperature threshold (C)*/
+#define TRIGGER_POLL_MS         100  /* Wait for a triggered frame in steps of (ms) */
+#define TRIGGER_FRAME_TIMEOUT   5    /* Soft triggered frame is given up this long after the exposure (s) */
 
 #define CONTROL_TAB "Controls"
+#define FOCUS_METRIC_TAB "Focus Metric"
+#define GUIDE_CENTROID_TAB "Guide Centroid"
+#define TRIGGER_TAB "Trigger"
 
 //#define USE_SIMULATION
 
@@ -170,6 +176,12 @@ void ASICCD::workerStreamVideo(const std::atomic_bool &isAboutToQuit)
         LOGF_ERROR("Failed to start video capture (%s).", Helpers::toString(ret));
     }
 
+    uint32_t frameWidth  = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
+    uint32_t frameHeight = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
+    // Raw bayer frames are measured on same-colour neighbours only
+    uint8_t  bayerStep   = (mCameraInfo.IsColorCam && (mCurrentVideoFormat == ASI_IMG_RAW8 ||
+                            mCurrentVideoFormat == ASI_IMG_RAW16) && !isMonoBinActive()) ? 2 : 1;
+
     while (!isAboutToQuit)
     {
         uint8_t *targetFrame = PrimaryCCD.getFrameBuffer();
@@ -194,12 +206,37 @@ void ASICCD::workerStreamVideo(const std::atomic_bool &isAboutToQuit)
             for (uint32_t i = 0; i < totalBytes; i += 3)
                 std::swap(targetFrame[i], targetFrame[i + 2]);
 
+        if (mFocusMetricMethod != FocusMetric::METHOD_OFF)
+            updateFocusMetric(targetFrame, frameWidth, frameHeight, bayerStep);
+
+        // Preview frames are throttled by the stream manager, the metric is published for every frame
         Streamer->newFrame(targetFrame, totalBytes);
     }
 
     ASIStopVideoCapture(mCameraInfo.CameraID);
 }
 
+void ASICCD::updateFocusMetric(const uint8_t *frame, uint32_t width, uint32_t height, uint8_t step)
+{
+    FocusMetric::Frame image;
+    image.data     = frame;
+    image.width    = width;
+    image.height   = height;
+    image.bpp      = (mCurrentVideoFormat == ASI_IMG_RAW16) ? 16 : 8;
+    image.channels = (mCurrentVideoFormat == ASI_IMG_RGB24) ? 3 : 1;
+    image.step     = step;
+
+    FocusMetric::ROI roi;
+    roi.x = static_cast<uint32_t>(FocusMetricROINP[FOCUS_ROI_X].getValue());
+    roi.y = static_cast<uint32_t>(FocusMetricROINP[FOCUS_ROI_Y].getValue());
+    roi.w = static_cast<uint32_t>(FocusMetricROINP[FOCUS_ROI_W].getValue());
+    roi.h = static_cast<uint32_t>(FocusMetricROINP[FOCUS_ROI_H].getValue());
+
+    FocusMetricNP[0].setValue(FocusMetric::compute(mFocusMetricMethod, image, roi));
+    FocusMetricNP.setState(IPS_OK);
+    FocusMetricNP.apply();
+}
+
 void ASICCD::workerBlinkExposure(const std::atomic_bool &isAboutToQuit, int blinks, float duration)
 {
     if (blinks <= 0)
@@ -373,6 +410,116 @@ void ASICCD::workerExposure(const std::atomic_bool &isAboutToQuit, float duratio
     grabImage(duration);
 }
 
+void ASICCD::workerTriggerExposure(const std::atomic_bool &isAboutToQuit, float duration)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    ASI_ERROR_CODE ret;
+    const bool isSoft  = (mCameraMode == ASI_MODE_TRIG_SOFT_EDGE || mCameraMode == ASI_MODE_TRIG_SOFT_LEVEL);
+    const bool isLevel = (mCameraMode == ASI_MODE_TRIG_SOFT_LEVEL || mCameraMode == ASI_MODE_TRIG_HIGH_LEVEL ||
+                          mCameraMode == ASI_MODE_TRIG_LOW_LEVEL);
+
+    PrimaryCCD.setExposureDuration(duration);
+
+    // With level triggers the exposure lasts as long as the trigger level
+    if (!isLevel)
+    {
+        ret = ASISetControlValue(mCameraInfo.CameraID, ASI_EXPOSURE, duration * 1000 * 1000, ASI_FALSE);
+        if (ret != ASI_SUCCESS)
+            LOGF_ERROR("Failed to set exposure duration (%s).", Helpers::toString(ret));
+    }
+
+    uint16_t subW = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
+    uint16_t subH = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
+    int nChannels = (getImageType() == ASI_IMG_RGB24) ? 3 : 1;
+    mTriggerFrame.resize(subW * subH * nChannels * (PrimaryCCD.getBPP() / 8));
+
+    // In trigger modes, frames are delivered through the video interface
+    ret = ASIStartVideoCapture(mCameraInfo.CameraID);
+    if (ret != ASI_SUCCESS)
+    {
+        LOGF_ERROR("Failed to arm triggered capture (%s).", Helpers::toString(ret));
+        PrimaryCCD.setExposureFailed();
+        return;
+    }
+
+    Clock::time_point triggered = Clock::now();
+    bool levelOpen = false;
+    if (isSoft)
+    {
+        ret = ASISendSoftTrigger(mCameraInfo.CameraID, ASI_TRUE);
+        triggered = Clock::now();
+        if (ret != ASI_SUCCESS)
+        {
+            LOGF_ERROR("Failed to send soft trigger (%s).", Helpers::toString(ret));
+            ASIStopVideoCapture(mCameraInfo.CameraID);
+            PrimaryCCD.setExposureFailed();
+            return;
+        }
+        levelOpen = (mCameraMode == ASI_MODE_TRIG_SOFT_LEVEL);
+    }
+    else
+    {
+        LOGF_INFO("Waiting for %s...", Helpers::toPrettyString(mCameraMode));
+    }
+
+    do
+    {
+        if (isAboutToQuit)
+        {
+            if (levelOpen)
+                ASISendSoftTrigger(mCameraInfo.CameraID, ASI_FALSE);
+            ASIStopVideoCapture(mCameraInfo.CameraID);
+            return;
+        }
+
+        int waitMS = TRIGGER_POLL_MS;
+        if (isSoft)
+        {
+            double elapsed = std::chrono::duration<double>(Clock::now() - triggered).count();
+
+            // The soft level trigger ends the exposure when it is released
+            if (levelOpen && elapsed >= duration)
+            {
+                ASISendSoftTrigger(mCameraInfo.CameraID, ASI_FALSE);
+                levelOpen = false;
+            }
+            else if (levelOpen)
+            {
+                waitMS = std::min(waitMS, static_cast<int>(std::ceil((duration - elapsed) * 1000)));
+            }
+
+            if (elapsed > duration + TRIGGER_FRAME_TIMEOUT)
+            {
+                LOGF_ERROR("No frame %d seconds after the soft trigger exposure ended.", TRIGGER_FRAME_TIMEOUT);
+                ASIStopVideoCapture(mCameraInfo.CameraID);
+                PrimaryCCD.setExposureFailed();
+                return;
+            }
+            PrimaryCCD.setExposureLeft(std::max(duration - elapsed, 0.0));
+        }
+
+        ret = ASIGetVideoData(mCameraInfo.CameraID, mTriggerFrame.data(), mTriggerFrame.size(), waitMS);
+    }
+    while (ret == ASI_ERROR_TIMEOUT);
+
+    Clock::time_point arrived = Clock::now();
+    ASIStopVideoCapture(mCameraInfo.CameraID);
+
+    if (ret != ASI_SUCCESS)
+    {
+        LOGF_ERROR("Failed to read triggered frame (%s).", Helpers::toString(ret));
+        PrimaryCCD.setExposureFailed();
+        return;
+    }
+
+    // The host side delay beyond the exposure is only known when the host sent the trigger
+    updateTriggerStats(isSoft, std::chrono::duration<double, std::milli>(arrived - triggered).count() - duration * 1000.0);
+
+    PrimaryCCD.setExposureLeft(0.0);
+    grabImage(duration, mTriggerFrame.data());
+}
+
 ASICCD::ASICCD(const ASI_CAMERA_INFO &camInfo, const std::string &cameraName)
     : mCameraName(cameraName)
     , mCameraInfo(camInfo)
@@ -418,6 +565,44 @@ bool ASICCD::initProperties()
     BlinkNP[BLINK_DURATION].fill("BLINK_DURATION", "Blink duration",         "%2.3f", 0,  60, 0.001, 0);
     BlinkNP.fill(getDeviceName(), "BLINK", "Blink", CONTROL_TAB, IP_RW, 60, IPS_IDLE);
 
+    FocusMetricSP[FocusMetric::METHOD_OFF      ].fill("FOCUS_METRIC_OFF",       "Off",               ISS_ON);
+    FocusMetricSP[FocusMetric::METHOD_LAPLACIAN].fill("FOCUS_METRIC_LAPLACIAN", "Laplacian variance", ISS_OFF);
+    FocusMetricSP[FocusMetric::METHOD_BRENNER  ].fill("FOCUS_METRIC_BRENNER",   "Brenner gradient",   ISS_OFF);
+    FocusMetricSP[FocusMetric::METHOD_HFR      ].fill("FOCUS_METRIC_HFR",       "HFR",                ISS_OFF);
+    FocusMetricSP.fill(getDeviceName(), "CCD_FOCUS_METRIC_MODE", "Metric", FOCUS_METRIC_TAB, IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+
+    // ROI is in pixels of the streamed (binned) frame, zero width or height selects the whole frame
+    FocusMetricROINP[FOCUS_ROI_X].fill("X", "Left",   "%.f", 0, 16000, 1, 0);
+    FocusMetricROINP[FOCUS_ROI_Y].fill("Y", "Top",    "%.f", 0, 16000, 1, 0);
+    FocusMetricROINP[FOCUS_ROI_W].fill("WIDTH",  "Width",  "%.f", 0, 16000, 1, 0);
+    FocusMetricROINP[FOCUS_ROI_H].fill("HEIGHT", "Height", "%.f", 0, 16000, 1, 0);
+    FocusMetricROINP.fill(getDeviceName(), "CCD_FOCUS_METRIC_ROI", "ROI", FOCUS_METRIC_TAB, IP_RW, 60, IPS_IDLE);
+
+    FocusMetricNP[0].fill("FOCUS_METRIC_VALUE", "Value", "%.3f", 0, 1e12, 0, 0);
+    FocusMetricNP.fill(getDeviceName(), "CCD_FOCUS_METRIC", "Focus Metric", FOCUS_METRIC_TAB, IP_RO, 60, IPS_IDLE);
+
+    // Tracking box in frame pixels, it follows the star. Zero size selects the whole frame.
+    GuideCentroidProperties.init(getDeviceName(), "CCD_GUIDE", GUIDE_CENTROID_TAB);
+
+    CameraModeSP.fill(getDeviceName(), "CCD_TRIGGER_MODE", "Mode", TRIGGER_TAB, IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+
+    // Delay and duration of the valid level after a trigger, zero duration disables the pin
+    TriggerOutputNP[TRIGGER_PIN_A_DELAY   ].fill("PIN_A_DELAY",    "Pin A delay (ms)",    "%.3f", 0, 2000000, 1, 0);
+    TriggerOutputNP[TRIGGER_PIN_A_DURATION].fill("PIN_A_DURATION", "Pin A duration (ms)", "%.3f", 0, 2000000, 1, 0);
+    TriggerOutputNP[TRIGGER_PIN_B_DELAY   ].fill("PIN_B_DELAY",    "Pin B delay (ms)",    "%.3f", 0, 2000000, 1, 0);
+    TriggerOutputNP[TRIGGER_PIN_B_DURATION].fill("PIN_B_DURATION", "Pin B duration (ms)", "%.3f", 0, 2000000, 1, 0);
+    TriggerOutputNP.fill(getDeviceName(), "CCD_TRIGGER_OUTPUT", "Output", TRIGGER_TAB, IP_RW, 60, IPS_IDLE);
+
+    TriggerOutputLevelSP[0].fill("PIN_A_HIGH", "Pin A active high", ISS_ON);
+    TriggerOutputLevelSP[1].fill("PIN_B_HIGH", "Pin B active high", ISS_ON);
+    TriggerOutputLevelSP.fill(getDeviceName(), "CCD_TRIGGER_OUTPUT_LEVEL", "Output Level", TRIGGER_TAB, IP_RW, ISR_NOFMANY, 60, IPS_IDLE);
+
+    // Latency is the time from the soft trigger to the frame beyond the exposure duration
+    TriggerStatsNP[TRIGGER_LATENCY].fill("LATENCY", "Latency (ms)", "%.3f", 0, 1e6, 0, 0);
+    TriggerStatsNP[TRIGGER_JITTER ].fill("JITTER",  "Jitter (ms)",  "%.3f", 0, 1e6, 0, 0);
+    TriggerStatsNP[TRIGGER_FRAMES ].fill("FRAMES",  "Frames",       "%.f",  0, 1e9, 0, 0);
+    TriggerStatsNP.fill(getDeviceName(), "CCD_TRIGGER_STATS", "Statistics", TRIGGER_TAB, IP_RO, 60, IPS_IDLE);
+
     IUSaveText(&BayerT[2], getBayerString());
 
     ADCDepthNP[0].fill("BITS", "Bits", "%2.0f", 0, 32, 1, mCameraInfo.BitDepth);
@@ -528,6 +713,22 @@ bool ASICCD::updateProperties()
         }
 
         defineProperty(BlinkNP);
+        defineProperty(FocusMetricSP);
+        defineProperty(FocusMetricROINP);
+        defineProperty(FocusMetricNP);
+        GuideCentroidProperties.define(this);
+
+        if (mCameraInfo.IsTriggerCam)
+        {
+            defineProperty(CameraModeSP);
+            loadConfig(true, CameraModeSP.getName());
+            defineProperty(TriggerOutputLevelSP);
+            loadConfig(true, TriggerOutputLevelSP.getName());
+            defineProperty(TriggerOutputNP);
+            loadConfig(true, TriggerOutputNP.getName());
+            defineProperty(TriggerStatsNP);
+        }
+
         defineProperty(ADCDepthNP);
         defineProperty(SDKVersionSP);
     }
@@ -551,6 +752,19 @@ bool ASICCD::updateProperties()
             deleteProperty(VideoFormatSP.getName());
 
         deleteProperty(BlinkNP.getName());
+        deleteProperty(FocusMetricSP.getName());
+        deleteProperty(FocusMetricROINP.getName());
+        deleteProperty(FocusMetricNP.getName());
+        GuideCentroidProperties.remove(this);
+
+        if (mCameraInfo.IsTriggerCam)
+        {
+            deleteProperty(CameraModeSP.getName());
+            deleteProperty(TriggerOutputLevelSP.getName());
+            deleteProperty(TriggerOutputNP.getName());
+            deleteProperty(TriggerStatsNP.getName());
+        }
+
         deleteProperty(SDKVersionSP.getName());
         deleteProperty(ADCDepthNP.getName());
     }
@@ -704,6 +918,45 @@ void ASICCD::setupParams()
         VideoFormatSP.push(std::move(node));
     }
 
+    if (mCameraInfo.IsTriggerCam)
+    {
+        mSupportedModes.SupportedCameraMode[0] = ASI_MODE_END;
+        ret = ASIGetCameraSupportMode(mCameraInfo.CameraID, &mSupportedModes);
+        if (ret != ASI_SUCCESS)
+            LOGF_ERROR("Failed to get supported camera modes (%s).", Helpers::toString(ret));
+
+        ret = ASIGetCameraMode(mCameraInfo.CameraID, &mCameraMode);
+        if (ret != ASI_SUCCESS)
+        {
+            LOGF_ERROR("Failed to get camera mode (%s).", Helpers::toString(ret));
+            mCameraMode = ASI_MODE_NORMAL;
+        }
+
+        CameraModeSP.resize(0);
+        for (const auto &mode : mSupportedModes.SupportedCameraMode)
+        {
+            if (mode == ASI_MODE_END)
+                break;
+
+            INDI::WidgetSwitch node;
+            node.fill(Helpers::toString(mode), Helpers::toPrettyString(mode), mode == mCameraMode ? ISS_ON : ISS_OFF);
+            node.setAux(const_cast<ASI_CAMERA_MODE*>(&mode));
+            CameraModeSP.push(std::move(node));
+        }
+
+        const ASI_TRIG_OUTPUT_PIN pins[2] = { ASI_TRIG_OUTPUT_PINA, ASI_TRIG_OUTPUT_PINB };
+        for (int i = 0; i < 2; i++)
+        {
+            ASI_BOOL isHigh = ASI_TRUE;
+            long delay = 0, duration = 0;
+            if (ASIGetTriggerOutputIOConf(mCameraInfo.CameraID, pins[i], &isHigh, &delay, &duration) != ASI_SUCCESS)
+                continue;
+            TriggerOutputNP[2 * i    ].setValue(delay / 1000.0);
+            TriggerOutputNP[2 * i + 1].setValue(duration / 1000.0);
+            TriggerOutputLevelSP[i].setState(isHigh ? ISS_ON : ISS_OFF);
+        }
+    }
+
     float x_pixel_size = mCameraInfo.PixelSize;
     float y_pixel_size = mCameraInfo.PixelSize;
 
@@ -820,6 +1073,23 @@ bool ASICCD::ISNewNumber(const char *dev, const char *name, double values[], cha
             BlinkNP.apply();
             return true;
         }
+
+        if (FocusMetricROINP.isNameMatch(name))
+        {
+            FocusMetricROINP.setState(FocusMetricROINP.update(values, names, n) ? IPS_OK : IPS_ALERT);
+            FocusMetricROINP.apply();
+            return true;
+        }
+
+        if (GuideCentroidProperties.processNumber(name, values, names, n))
+            return true;
+
+        if (TriggerOutputNP.isNameMatch(name))
+        {
+            TriggerOutputNP.setState(TriggerOutputNP.update(values, names, n) && setTriggerOutput() ? IPS_OK : IPS_ALERT);
+            TriggerOutputNP.apply();
+            return true;
+        }
     }
 
     return INDI::CCD::ISNewNumber(dev, name, values, names, n);
@@ -872,6 +1142,48 @@ bool ASICCD::ISNewSwitch(const char *dev, const char *name, ISState *states, cha
             return true;
         }
 
+        if (FocusMetricSP.isNameMatch(name))
+        {
+            if (!FocusMetricSP.update(states, names, n))
+            {
+                FocusMetricSP.setState(IPS_ALERT);
+                FocusMetricSP.apply();
+                return true;
+            }
+
+            mFocusMetricMethod = static_cast<FocusMetric::Method>(FocusMetricSP.findOnSwitchIndex());
+            FocusMetricSP.setState(IPS_OK);
+            FocusMetricSP.apply();
+            return true;
+        }
+
+        // The full frame request is served and reset with the next frame
+        if (GuideCentroidProperties.processSwitch(name, states, names, n))
+            return true;
+
+        if (CameraModeSP.isNameMatch(name))
+        {
+            const char *targetMode = IUFindOnSwitchName(states, names, n);
+            int targetIndex = CameraModeSP.findWidgetIndexByName(targetMode);
+
+            if (targetIndex == -1)
+            {
+                LOGF_ERROR("Unable to locate mode %s.", targetMode);
+                CameraModeSP.setState(IPS_ALERT);
+                CameraModeSP.apply();
+                return true;
+            }
+
+            return setCameraMode(targetIndex);
+        }
+
+        if (TriggerOutputLevelSP.isNameMatch(name))
+        {
+            TriggerOutputLevelSP.setState(TriggerOutputLevelSP.update(states, names, n) && setTriggerOutput() ? IPS_OK : IPS_ALERT);
+            TriggerOutputLevelSP.apply();
+            return true;
+        }
+
         /* Cooler */
         if (CoolerSP.isNameMatch(name))
         {
@@ -993,7 +1305,10 @@ bool ASICCD::activateCooler(bool enable)
 
 bool ASICCD::StartExposure(float duration)
 {
-    mWorker.start(std::bind(&ASICCD::workerExposure, this, std::placeholders::_1, duration));
+    if (mCameraMode != ASI_MODE_NORMAL)
+        mWorker.start(std::bind(&ASICCD::workerTriggerExposure, this, std::placeholders::_1, duration));
+    else
+        mWorker.start(std::bind(&ASICCD::workerExposure, this, std::placeholders::_1, duration));
     return true;
 }
 
@@ -1034,6 +1349,12 @@ bool ASICCD::StartStreaming()
         }
     }
 #endif
+    if (mCameraMode != ASI_MODE_NORMAL)
+    {
+        LOG_ERROR("Streaming is only available in normal camera mode.");
+        return false;
+    }
+
     mWorker.start(std::bind(&ASICCD::workerStreamVideo, this, std::placeholders::_1));
     return true;
 }
@@ -1127,7 +1448,7 @@ bool ASICCD::UpdateCCDBin(int binx, int biny)
 
 /* Downloads the image from the CCD.
  N.B. No processing is done on the image */
-int ASICCD::grabImage(float duration)
+int ASICCD::grabImage(float duration, const uint8_t *frame)
 {
     ASI_ERROR_CODE ret = ASI_SUCCESS;
 
@@ -1152,7 +1473,10 @@ int ASICCD::grabImage(float duration)
         }
     }
 
-    ret = ASIGetDataAfterExp(mCameraInfo.CameraID, buffer, nTotalBytes);
+    if (frame != nullptr)
+        memcpy(buffer, frame, nTotalBytes);
+    else
+        ret = ASIGetDataAfterExp(mCameraInfo.CameraID, buffer, nTotalBytes);
     if (ret != ASI_SUCCESS)
     {
         LOGF_ERROR(
@@ -1195,6 +1519,16 @@ int ASICCD::grabImage(float duration)
     if (duration > VERBOSE_EXPOSURE)
         LOG_INFO("Download complete.");
 
+    // RGB24 was converted to planes above
+    GuideCentroid::Frame star = { image, static_cast<uint32_t>(subW), static_cast<uint32_t>(subH),
+                                  static_cast<uint8_t>(PrimaryCCD.getBPP()), static_cast<uint8_t>(nChannels), true };
+    if (GuideCentroidProperties.isEnabled() && !GuideCentroidProperties.update(star))
+    {
+        // Centroid only, the frame is not sent
+        GuideCentroid::completeExposure(this, &PrimaryCCD, "CCD_EXPOSURE");
+        return 0;
+    }
+
     ExposureComplete(&PrimaryCCD);
     return 0;
 }
@@ -1483,6 +1817,97 @@ void ASICCD::updateRecorderFormat()
     );
 }
 
+bool ASICCD::setCameraMode(int index)
+{
+    auto mode = *static_cast<ASI_CAMERA_MODE*>(CameraModeSP[index].getAux());
+    if (mode == mCameraMode)
+    {
+        CameraModeSP.reset();
+        CameraModeSP[index].setState(ISS_ON);
+        CameraModeSP.setState(IPS_OK);
+        CameraModeSP.apply();
+        return true;
+    }
+
+    // The camera only changes mode while no capture is running
+    if (PrimaryCCD.isExposing() || Streamer->isBusy())
+    {
+        LOG_ERROR("Cannot change camera mode while exposing or streaming.");
+        CameraModeSP.setState(IPS_ALERT);
+        CameraModeSP.apply();
+        return true;
+    }
+
+    ASI_ERROR_CODE ret = ASISetCameraMode(mCameraInfo.CameraID, mode);
+    if (ret != ASI_SUCCESS)
+    {
+        LOGF_ERROR("Failed to set %s mode (%s).", Helpers::toPrettyString(mode), Helpers::toString(ret));
+        CameraModeSP.setState(IPS_ALERT);
+        CameraModeSP.apply();
+        return false;
+    }
+
+    mCameraMode = mode;
+    CameraModeSP.reset();
+    CameraModeSP[index].setState(ISS_ON);
+    CameraModeSP.setState(IPS_OK);
+    CameraModeSP.apply();
+    LOGF_INFO("Camera mode is %s.", Helpers::toPrettyString(mode));
+
+    // Statistics are per mode
+    mTriggerFrames      = 0;
+    mTriggerLatencyMean = 0;
+    mTriggerLatencyM2   = 0;
+    for (auto &num : TriggerStatsNP)
+        num.setValue(0);
+    TriggerStatsNP.setState(IPS_IDLE);
+    TriggerStatsNP.apply();
+    return true;
+}
+
+bool ASICCD::setTriggerOutput()
+{
+    const ASI_TRIG_OUTPUT_PIN pins[2] = { ASI_TRIG_OUTPUT_PINA, ASI_TRIG_OUTPUT_PINB };
+    for (int i = 0; i < 2; i++)
+    {
+        ASI_BOOL isHigh = TriggerOutputLevelSP[i].getState() == ISS_ON ? ASI_TRUE : ASI_FALSE;
+        long delay      = static_cast<long>(TriggerOutputNP[2 * i    ].getValue() * 1000);
+        long duration   = static_cast<long>(TriggerOutputNP[2 * i + 1].getValue() * 1000);
+
+        ASI_ERROR_CODE ret = ASISetTriggerOutputIOConf(mCameraInfo.CameraID, pins[i], isHigh, delay, duration);
+        if (ret != ASI_SUCCESS)
+        {
+            LOGF_ERROR("Failed to configure trigger output pin %c (%s).", 'A' + i, Helpers::toString(ret));
+            return false;
+        }
+    }
+    return true;
+}
+
+void ASICCD::updateTriggerStats(bool isSoft, double latencyMS)
+{
+    TriggerStatsNP[TRIGGER_FRAMES].setValue(TriggerStatsNP[TRIGGER_FRAMES].getValue() + 1);
+
+    // Externally triggered frames are counted only, their trigger time is unknown to the host
+    if (isSoft)
+    {
+        // Welford's running variance
+        mTriggerFrames++;
+        double delta = latencyMS - mTriggerLatencyMean;
+        mTriggerLatencyMean += delta / mTriggerFrames;
+        mTriggerLatencyM2   += delta * (latencyMS - mTriggerLatencyMean);
+
+        double jitter = mTriggerFrames > 1 ? std::sqrt(mTriggerLatencyM2 / (mTriggerFrames - 1)) : 0;
+        TriggerStatsNP[TRIGGER_LATENCY].setValue(latencyMS);
+        TriggerStatsNP[TRIGGER_JITTER ].setValue(jitter);
+        LOGF_DEBUG("Soft trigger latency %.3f ms, mean %.3f ms, jitter %.3f ms over %u frames.",
+                   latencyMS, mTriggerLatencyMean, jitter, mTriggerFrames);
+    }
+
+    TriggerStatsNP.setState(IPS_OK);
+    TriggerStatsNP.apply();
+}
+
 void ASICCD::addFITSKeywords(fitsfile *fptr, INDI::CCDChip *targetChip)
 {
     INDI::CCD::addFITSKeywords(fptr, targetChip);
@@ -1520,6 +1945,16 @@ bool ASICCD::saveConfigItems(FILE *fp)
         VideoFormatSP.save(fp);
 
     BlinkNP.save(fp);
+    FocusMetricSP.save(fp);
+    FocusMetricROINP.save(fp);
+    GuideCentroidProperties.save(fp);
+
+    if (mCameraInfo.IsTriggerCam)
+    {
+        CameraModeSP.save(fp);
+        TriggerOutputLevelSP.save(fp);
+        TriggerOutputNP.save(fp);
+    }
 
     return true;
 }
@@ -28,7 +28,10 @@
 #include "indipropertynumber.h"
 #include "indipropertytext.h"
 #include "indisinglethreadpool.h"
+#include "focus_metric.h"
+#include "guide_centroid_properties.h"
 
+#include <atomic>
 #include <vector>
 
 #include <indiccd.h>
@@ -85,9 +88,13 @@ private:
     void workerStreamVideo(const std::atomic_bool &isAboutToQuit);
     void workerBlinkExposure(const std::atomic_bool &isAboutToQuit, int blinks, float duration);
     void workerExposure(const std::atomic_bool &isAboutToQuit, float duration);
+    void workerTriggerExposure(const std::atomic_bool &isAboutToQuit, float duration);
 
-    /** Get image from CCD and send it to client */
-    int grabImage(float duration);
+    /** Get image from CCD and send it to client, frame is set if it was already read from a triggered capture */
+    int grabImage(float duration, const uint8_t *frame = nullptr);
+
+    /** Compute and publish focus metric of the streamed frame */
+    void updateFocusMetric(const uint8_t *frame, uint32_t width, uint32_t height, uint8_t step);
 
 private:
     double mTargetTemperature;
@@ -126,6 +133,15 @@ private:
     /** Get if MonoBin is active, thus Bayer is irrelevant */
     bool isMonoBinActive();
 
+    /** Set camera mode, only while no capture is running */
+    bool setCameraMode(int index);
+
+    /** Configure trigger output pins from TriggerOutputNP and TriggerOutputLevelSP */
+    bool setTriggerOutput();
+
+    /** Count a triggered frame, and add its start-to-frame latency to the statistics if it was soft triggered */
+    void updateTriggerStats(bool isSoft, double latencyMS);
+
 private:
     /** Additional Properties to INDI::CCD */
     INDI::PropertyNumber  CoolerNP {1};
@@ -144,9 +160,47 @@ private:
         BLINK_DURATION
     };
 
+    INDI::PropertySwitch  FocusMetricSP {4};
+    INDI::PropertyNumber  FocusMetricROINP {4};
+    INDI::PropertyNumber  FocusMetricNP {1};
+
+    GuideCentroid::Properties GuideCentroidProperties;
+
+    INDI::PropertySwitch  CameraModeSP {0};
+    INDI::PropertyNumber  TriggerOutputNP {4};
+    enum {
+        TRIGGER_PIN_A_DELAY,
+        TRIGGER_PIN_A_DURATION,
+        TRIGGER_PIN_B_DELAY,
+        TRIGGER_PIN_B_DURATION
+    };
+    INDI::PropertySwitch  TriggerOutputLevelSP {2};
+    INDI::PropertyNumber  TriggerStatsNP {3};
+    enum {
+        TRIGGER_LATENCY,
+        TRIGGER_JITTER,
+        TRIGGER_FRAMES
+    };
+
+    enum {
+        FOCUS_ROI_X,
+        FOCUS_ROI_Y,
+        FOCUS_ROI_W,
+        FOCUS_ROI_H
+    };
+
 private:
     std::string mCameraName;
     uint8_t mExposureRetry {0};
+    std::atomic<FocusMetric::Method> mFocusMetricMethod {FocusMetric::METHOD_OFF};
+
+    ASI_CAMERA_MODE               mCameraMode {ASI_MODE_NORMAL};
+    ASI_SUPPORTED_MODE            mSupportedModes;
+    std::vector<uint8_t>          mTriggerFrame;
+    // Running mean and sum of squared deviations of the soft trigger latency (ms)
+    uint32_t mTriggerFrames {0};
+    double   mTriggerLatencyMean {0};
+    double   mTriggerLatencyM2 {0};
 
     ASI_IMG_TYPE                  mCurrentVideoFormat;
     std::vector<ASI_CONTROL_CAPS> mControlCaps;
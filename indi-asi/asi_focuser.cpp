@@ -31,6 +31,9 @@
 
 #define MAX_DEVICES 4
 #define FOCUS_SETTINGS_TAB "Settings"
+#define MOVE_POLL_PERIOD 50         // ms, completion polling while a move is in progress
+#define TEMPERATURE_PERIOD 5000     // ms, temperature sampling
+#define TEMPERATURE_SMOOTHING 0.25  // weight of a new temperature sample
 
 static int iAvailableFocusersCount;
 static ASIEAF * focusers[MAX_DEVICES];
@@ -230,7 +233,8 @@ bool ASIEAF::initProperties()
     FocusAbsPosN[0].value = 0;
     FocusAbsPosN[0].step  = m_MaxSteps / 20.0;
 
-    setDefaultPollingPeriod(500);
+    // Moves are polled separately, this is the idle cadence
+    setDefaultPollingPeriod(1000);
 
     addDebugControl();
 
@@ -268,7 +272,7 @@ bool ASIEAF::updateProperties()
 
         LOG_INFO("ASI EAF parameters updated, focuser ready for use.");
 
-        SetTimer(getCurrentPollingPeriod());
+        m_TimerID = SetTimer(getCurrentPollingPeriod());
     }
     else
     {
@@ -316,7 +320,11 @@ bool ASIEAF::readTemperature()
         return false;
     }
 
-    TemperatureN[0].value = temperature;
+    // The sensor reading jitters by a few tenths, publish an exponential average
+    if (m_TemperatureSamples++ == 0)
+        TemperatureN[0].value = temperature;
+    else
+        TemperatureN[0].value += TEMPERATURE_SMOOTHING * (temperature - TemperatureN[0].value);
     return true;
 }
 
@@ -460,6 +468,13 @@ bool ASIEAF::gotoAbsolute(uint32_t position)
         LOGF_ERROR("Failed to set position. Error: %d", rc);
         return false;
     }
+
+    m_MoveStart = m_LastMovingCheck = std::chrono::steady_clock::now();
+
+    // Poll for completion right away instead of waiting for the idle timer
+    if (m_TimerID > 0)
+        RemoveTimer(m_TimerID);
+    m_TimerID = SetTimer(MOVE_POLL_PERIOD);
     return true;
 }
 
@@ -577,10 +592,12 @@ void ASIEAF::TimerHit()
 {
     if (!isConnected())
     {
-        SetTimer(getCurrentPollingPeriod());
+        m_TimerID = SetTimer(getCurrentPollingPeriod());
         return;
     }
 
+    bool moving = (FocusAbsPosNP.s == IPS_BUSY || FocusRelPosNP.s == IPS_BUSY);
+
     bool rc = readPosition();
     if (rc)
     {
@@ -591,8 +608,12 @@ void ASIEAF::TimerHit()
         }
     }
 
-    if (TemperatureNP.s != IPS_IDLE)
+    // Temperature is sampled on its own schedule, and not while moving
+    auto now = std::chrono::steady_clock::now();
+    if (TemperatureNP.s != IPS_IDLE && !moving &&
+            now - m_LastTemperatureRead >= std::chrono::milliseconds(TEMPERATURE_PERIOD))
     {
+        m_LastTemperatureRead = now;
         rc = readTemperature();
         if (rc)
         {
@@ -604,20 +625,27 @@ void ASIEAF::TimerHit()
         }
     }
 
-    if (FocusAbsPosNP.s == IPS_BUSY || FocusRelPosNP.s == IPS_BUSY)
+    if (moving)
     {
         if (!isMoving())
         {
+            now = std::chrono::steady_clock::now();
             FocusAbsPosNP.s = IPS_OK;
             FocusRelPosNP.s = IPS_OK;
             IDSetNumber(&FocusAbsPosNP, nullptr);
             IDSetNumber(&FocusRelPosNP, nullptr);
             lastPos = FocusAbsPosN[0].value;
             LOG_INFO("Focuser reached requested position.");
+            LOGF_DEBUG("Move took %.f ms, completion reported within %.f ms of the stop.",
+                       std::chrono::duration<double, std::milli>(now - m_MoveStart).count(),
+                       std::chrono::duration<double, std::milli>(now - m_LastMovingCheck).count());
+            moving = false;
         }
+        else
+            m_LastMovingCheck = std::chrono::steady_clock::now();
     }
 
-    SetTimer(getCurrentPollingPeriod());
+    m_TimerID = SetTimer(moving ? MOVE_POLL_PERIOD : getCurrentPollingPeriod());
 }
 
 bool ASIEAF::AbortFocuser()
@@ -102,6 +102,13 @@ class ASIEAF : public INDI::Focuser
 
         double targetPos { 0 }, lastPos { 0 }, lastTemperature { 0 };
 
+        int m_TimerID { -1 };
+        // Start of the current move and the last poll that found it still running
+        std::chrono::steady_clock::time_point m_MoveStart, m_LastMovingCheck;
+        std::chrono::steady_clock::time_point m_LastTemperatureRead;
+        // Number of temperature samples in the smoothed value
+        uint32_t m_TemperatureSamples { 0 };
+
         // Read Only Temperature Reporting
         INumber TemperatureN[1];
         INumberVectorProperty TemperatureNP;
@@ -103,6 +103,36 @@ const char *toPrettyString(ASI_IMG_TYPE type)
     }
 }
 
+const char *toString(ASI_CAMERA_MODE mode)
+{
+    switch (mode)
+    {
+    case ASI_MODE_NORMAL:          return "MODE_NORMAL";
+    case ASI_MODE_TRIG_SOFT_EDGE:  return "MODE_TRIG_SOFT_EDGE";
+    case ASI_MODE_TRIG_RISE_EDGE:  return "MODE_TRIG_RISE_EDGE";
+    case ASI_MODE_TRIG_FALL_EDGE:  return "MODE_TRIG_FALL_EDGE";
+    case ASI_MODE_TRIG_SOFT_LEVEL: return "MODE_TRIG_SOFT_LEVEL";
+    case ASI_MODE_TRIG_HIGH_LEVEL: return "MODE_TRIG_HIGH_LEVEL";
+    case ASI_MODE_TRIG_LOW_LEVEL:  return "MODE_TRIG_LOW_LEVEL";
+    default:                       return "UNKNOWN";
+    }
+}
+
+const char *toPrettyString(ASI_CAMERA_MODE mode)
+{
+    switch (mode)
+    {
+    case ASI_MODE_NORMAL:          return "Normal";
+    case ASI_MODE_TRIG_SOFT_EDGE:  return "Soft edge trigger";
+    case ASI_MODE_TRIG_RISE_EDGE:  return "Rising edge trigger";
+    case ASI_MODE_TRIG_FALL_EDGE:  return "Falling edge trigger";
+    case ASI_MODE_TRIG_SOFT_LEVEL: return "Soft level trigger";
+    case ASI_MODE_TRIG_HIGH_LEVEL: return "High level trigger";
+    case ASI_MODE_TRIG_LOW_LEVEL:  return "Low level trigger";
+    default:                       return "UNKNOWN";
+    }
+}
+
 INDI_PIXEL_FORMAT pixelFormat(ASI_IMG_TYPE type, ASI_BAYER_PATTERN pattern, bool isColor)
 {
     if (isColor == false)
@@ -0,0 +1,199 @@
+/*
+    Star centroid measured on guide frames
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace GuideCentroid
+{
+
+/** Frame as delivered by the camera, sizes in (binned) pixels */
+struct Frame
+{
+    const uint8_t *data;
+    uint32_t width;
+    uint32_t height;
+    uint8_t bpp;        // 8 or 16
+    uint8_t channels;   // 1 for mono/raw, 3 for RGB
+    bool planar;        // RGB stored as three consecutive planes instead of interleaved
+};
+
+struct Result
+{
+    bool valid {false};
+    double x {0};       // subpixel position in frame pixels
+    double y {0};
+    double flux {0};    // background subtracted flux in ADU
+    double snr {0};
+};
+
+namespace Detail
+{
+
+template <typename T>
+Result compute(const T *img, uint32_t width, uint32_t height, uint32_t boxX, uint32_t boxY, uint32_t boxSize)
+{
+    Result result;
+
+    uint32_t x0 = std::min(boxX, width);
+    uint32_t y0 = std::min(boxY, height);
+    uint32_t x1 = (boxSize == 0) ? width  : std::min(boxX + boxSize, width);
+    uint32_t y1 = (boxSize == 0) ? height : std::min(boxY + boxSize, height);
+
+    if (x1 < x0 + 5 || y1 < y0 + 5)
+        return result;
+
+    // Background and noise from the box border
+    double sum = 0, sumSq = 0;
+    size_t count = 0;
+    for (uint32_t y = y0; y < y1; ++y)
+    {
+        const T *row = img + size_t(y) * width;
+        uint32_t step = (y == y0 || y + 1 == y1) ? 1 : x1 - x0 - 1;
+        for (uint32_t x = x0; x < x1; x += step)
+        {
+            sum   += row[x];
+            sumSq += double(row[x]) * row[x];
+            ++count;
+        }
+    }
+    const double background = sum / count;
+    const double sigma      = std::sqrt(std::max(0.0, sumSq / count - background * background));
+
+    // Peak of the 3x3 box sum, less sensitive to hot pixels than a single pixel maximum
+    uint32_t peakX = 0, peakY = 0;
+    double peak = -1;
+    for (uint32_t y = y0 + 1; y + 1 < y1; ++y)
+    {
+        const T *up   = img + size_t(y - 1) * width;
+        const T *row  = img + size_t(y) * width;
+        const T *down = img + size_t(y + 1) * width;
+        for (uint32_t x = x0 + 1; x + 1 < x1; ++x)
+        {
+            double v = double(up[x - 1]) + up[x] + up[x + 1] +
+                       row[x - 1] + row[x] + row[x + 1] +
+                       down[x - 1] + down[x] + down[x + 1];
+            if (v > peak)
+            {
+                peak  = v;
+                peakX = x;
+                peakY = y;
+            }
+        }
+    }
+
+    // Require the peak to stand out from the background
+    if (peak / 9 - background < 3 * sigma)
+        return result;
+
+    // Flux weighted centroid within a window around the peak
+    const uint32_t radius = std::max<uint32_t>(2, (std::min(x1 - x0, y1 - y0)) / 4);
+    uint32_t wx0 = std::max(x0, peakX > radius ? peakX - radius : 0);
+    uint32_t wy0 = std::max(y0, peakY > radius ? peakY - radius : 0);
+    uint32_t wx1 = std::min(x1, peakX + radius + 1);
+    uint32_t wy1 = std::min(y1, peakY + radius + 1);
+
+    double flux = 0, cx = 0, cy = 0;
+    size_t pixels = 0;
+    for (uint32_t y = wy0; y < wy1; ++y)
+    {
+        const T *row = img + size_t(y) * width;
+        for (uint32_t x = wx0; x < wx1; ++x)
+        {
+            double v = row[x] - background;
+            ++pixels;
+            if (v <= 0)
+                continue;
+            flux += v;
+            cx   += v * x;
+            cy   += v * y;
+        }
+    }
+
+    if (flux <= 0)
+        return result;
+
+    result.valid = true;
+    result.x     = cx / flux;
+    result.y     = cy / flux;
+    result.flux  = flux;
+    // Poisson noise of the star in ADU plus background noise over the window
+    result.snr   = flux / std::sqrt(flux + pixels * sigma * sigma);
+    return result;
+}
+
+// Luminance of the box as the mean of the colour channels, so the result does not depend on their order
+template <typename T>
+Result luminance(const T *img, const Frame &frame, uint32_t boxX, uint32_t boxY, uint32_t boxSize)
+{
+    uint32_t x0 = std::min(boxX, frame.width);
+    uint32_t y0 = std::min(boxY, frame.height);
+    uint32_t x1 = (boxSize == 0) ? frame.width  : std::min(boxX + boxSize, frame.width);
+    uint32_t y1 = (boxSize == 0) ? frame.height : std::min(boxY + boxSize, frame.height);
+    uint32_t w  = x1 - x0;
+    uint32_t h  = y1 - y0;
+
+    const size_t plane   = size_t(frame.width) * frame.height;
+    const size_t pixel   = frame.planar ? 1 : 3;
+    const size_t channel = frame.planar ? plane : 1;
+
+    std::vector<float> box(size_t(w) * h);
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        const T *row = img + (size_t(y0 + y) * frame.width + x0) * pixel;
+        float *out   = box.data() + size_t(y) * w;
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            const T *p = row + x * pixel;
+            out[x] = (float(p[0]) + p[channel] + p[2 * channel]) / 3;
+        }
+    }
+
+    Result result = compute(box.data(), w, h, 0, 0, 0);
+    result.x += x0;
+    result.y += y0;
+    return result;
+}
+
+}
+
+/**
+ * @brief compute Locate the brightest star in the tracking box and measure its centroid.
+ * RGB frames are measured on their luminance.
+ * @param boxSize size of the square tracking box, zero selects the whole frame
+ */
+inline Result compute(const Frame &frame, uint32_t boxX, uint32_t boxY, uint32_t boxSize)
+{
+    if (frame.data == nullptr)
+        return Result();
+
+    if (frame.channels == 3)
+        return frame.bpp > 8
+               ? Detail::luminance(reinterpret_cast<const uint16_t *>(frame.data), frame, boxX, boxY, boxSize)
+               : Detail::luminance(frame.data, frame, boxX, boxY, boxSize);
+
+    return frame.bpp > 8
+           ? Detail::compute(reinterpret_cast<const uint16_t *>(frame.data), frame.width, frame.height, boxX, boxY, boxSize)
+           : Detail::compute(frame.data, frame.width, frame.height, boxX, boxY, boxSize);
+}
+
+}
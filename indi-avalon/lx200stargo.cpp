@@ -541,31 +541,18 @@ bool LX200StarGo::ReadScopeStatus()
     }
 
     LOG_DEBUG("################################ ReadScopeStatus (start) ################################");
-    int x, y;
-
-    if (! getMotorStatus(&x, &y))
-    {
-        LOG_INFO("Failed to parse motor state. Retrying...");
-        // retry once
-        if (! getMotorStatus(&x, &y))
-        {
-            LOG_ERROR("Cannot determine scope status, failed to parse motor state.");
-            return false;
-        }
-    }
+    serialTransactions = 0;
 
-    char parkHomeStatus[1] = {0};
-    if (! getParkHomeStatus(parkHomeStatus))
-    {
-        LOG_ERROR("Cannot determine scope status, failed to determine park/sync state.");
+    StatusSnapshot snapshot;
+    if (! readStatusSnapshot(&snapshot))
         return false;
-    }
-    LOGF_DEBUG("Mount state = %s", parkHomeStatus);
+
+    LOGF_DEBUG("Mount state = %s", snapshot.parkHome);
 
     INDI::Telescope::TelescopeStatus newTrackState = TrackState;
 
     // handle parking / unparking
-    if(strcmp(parkHomeStatus, "2") == 0)
+    if(strcmp(snapshot.parkHome, "2") == 0)
     {
         newTrackState = SCOPE_PARKED;
         if (TrackState != newTrackState)
@@ -577,7 +564,7 @@ bool LX200StarGo::ReadScopeStatus()
             SetParked(false);
 
         // handle tracking state
-        if(x == 0 && y == 0)
+        if(snapshot.motorRA == 0 && snapshot.motorDEC == 0)
         {
             newTrackState = SCOPE_IDLE;
             if (TrackState != newTrackState)
@@ -589,7 +576,7 @@ bool LX200StarGo::ReadScopeStatus()
                 IDSetSwitch(&MountGotoHomeSP, nullptr);
             }
         }
-        else if(x == 1 && y == 0)
+        else if(snapshot.motorRA == 1 && snapshot.motorDEC == 0)
         {
             newTrackState = SCOPE_TRACKING;  // or GUIDING
             if (TrackState != newTrackState)
@@ -597,30 +584,81 @@ bool LX200StarGo::ReadScopeStatus()
         }
     }
 
-    double r, d;
-    if(!getEqCoordinates(&r, &d))
-    {
-        LOG_ERROR("Retrieving equatorial coordinates failed.");
-        return false;
-    }
-    currentRA = r;
-    currentDEC = d;
+    currentRA = snapshot.ra;
+    currentDEC = snapshot.dec;
 
+    bool trackStateChanged = (TrackState != newTrackState);
     TrackState = newTrackState;
     NewRaDec(currentRA, currentDEC);
 
-    if (! syncSideOfPier())
+    // The pier side only changes while the motors slew, check it then and
+    // occasionally otherwise in case the mount was moved from the hand box.
+    bool motorsSlewing = snapshot.motorRA > 1 || snapshot.motorDEC > 1;
+    if (motorsSlewing || trackStateChanged || getPierSide() == INDI::Telescope::PIER_UNKNOWN ||
+            ++pollsSincePierSide >= AVALON_PIER_SIDE_POLL_INTERVAL)
     {
-        LOG_ERROR("Cannot determine scope status, failed to determine pier side.");
-        return false;
+        if (! syncSideOfPier())
+        {
+            LOG_ERROR("Cannot determine scope status, failed to determine pier side.");
+            return false;
+        }
+        pollsSincePierSide = 0;
     }
 
+    bool result = true;
+    if (snapshot.hasFocuserPosition)
+        result = focuserAux1->updateFocuserStatus(snapshot.focuserPosition);
+
+    LOGF_DEBUG("Status poll used %u serial transactions.", serialTransactions);
     LOG_DEBUG("################################ ReadScopeStatus (finish) ###############################");
 
-    if (focuserAux1.get() != nullptr && TrackState != SCOPE_SLEWING)
-        return focuserAux1.get()->ReadFocuserStatus();
-    else
-        return true;
+    return result;
+}
+
+/**
+ * @brief Query the mount state and, only if it needs it, the AUX1 focuser position.
+ * @param snapshot filled with the answers of this poll
+ * @return true if the mount state could be determined
+ */
+bool LX200StarGo::readStatusSnapshot(StatusSnapshot *snapshot)
+{
+    if (! getMotorStatus(&snapshot->motorRA, &snapshot->motorDEC))
+    {
+        LOG_INFO("Failed to parse motor state. Retrying...");
+        // retry once
+        if (! getMotorStatus(&snapshot->motorRA, &snapshot->motorDEC))
+        {
+            LOG_ERROR("Cannot determine scope status, failed to parse motor state.");
+            return false;
+        }
+    }
+
+    if (! getParkHomeStatus(snapshot->parkHome))
+    {
+        LOG_ERROR("Cannot determine scope status, failed to determine park/sync state.");
+        return false;
+    }
+
+    if(!getEqCoordinates(&snapshot->ra, &snapshot->dec))
+    {
+        LOG_ERROR("Retrieving equatorial coordinates failed.");
+        return false;
+    }
+
+    // An idle focuser keeps its last known position, no need to ask for it
+    if (focuserAux1.get() != nullptr && TrackState != SCOPE_SLEWING && focuserAux1->needsStatusUpdate())
+    {
+        // Command  - :X0BAUX1AS#
+        // Response - AX1=ppppppp#
+        char response[AVALON_RESPONSE_BUFFER_LENGTH] = {0};
+        if (sendQuery(":X0BAUX1AS#", response) &&
+                focuserAux1->parseFocuserPosition(response, &snapshot->focuserPosition))
+            snapshot->hasFocuserPosition = true;
+        else
+            LOG_WARN("Failed to read AUX1 focuser position.");
+    }
+
+    return true;
 }
 
 /**************************************************************************************
@@ -742,7 +780,7 @@ void LX200StarGo::getBasicData()
         else
             IDSetText(&MountFirmwareInfoTP, nullptr);
 
-        char parkHomeStatus[1] = {0};
+        char parkHomeStatus[AVALON_RESPONSE_BUFFER_LENGTH] = {0};
         if (getParkHomeStatus(parkHomeStatus))
         {
             SetParked(strcmp(parkHomeStatus, "2") == 0);
@@ -1832,6 +1870,7 @@ bool LX200StarGo::transmit(const char* buffer)
     //    LOG_DEBUG(__FUNCTION__);
     int bytesWritten = 0;
     flush();
+    serialTransactions++;
     int returnCode = tty_write_string(PortFD, buffer, &bytesWritten);
 
     if (returnCode != TTY_OK)
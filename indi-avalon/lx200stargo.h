@@ -38,6 +38,7 @@
 #define AVALON_TIMEOUT                                  2
 #define AVALON_COMMAND_BUFFER_LENGTH                    32
 #define AVALON_RESPONSE_BUFFER_LENGTH                   32
+#define AVALON_PIER_SIDE_POLL_INTERVAL                  10 /* status polls between pier side queries while not slewing */
 
 enum TDirection
 {
@@ -186,6 +187,23 @@ class LX200StarGo : public LX200Telescope
         // scope status
         virtual bool ParseMotionState(char* state);
 
+        // everything the mount and the AUX1 focuser need, collected once per ReadScopeStatus
+        struct StatusSnapshot
+        {
+            int motorRA {0};
+            int motorDEC {0};
+            char parkHome[AVALON_RESPONSE_BUFFER_LENGTH] = {0};
+            double ra {0};
+            double dec {0};
+            bool hasFocuserPosition {false};
+            int focuserPosition {0};
+        };
+        virtual bool readStatusSnapshot(StatusSnapshot *snapshot);
+
+        // commands sent to the controller, reported per status poll
+        uint32_t serialTransactions {0};
+        uint32_t pollsSincePierSide {AVALON_PIER_SIDE_POLL_INTERVAL};
+
         // location
         virtual bool sendScopeLocation();
         double LocalSiderealTime(double longitude);
@@ -337,13 +337,21 @@ bool LX200StarGoFocuser::ReadFocuserStatus() {
         return true;
 
     int absolutePosition = 0;
-    if (sendQueryFocuserPosition(&absolutePosition)) {
-        FocusAbsPosN[0].value = (focuserReversed == INDI_DISABLED) ? absolutePosition : -absolutePosition;
-        IDSetNumber(&FocusAbsPosNP, nullptr);
-    }
-    else
+    if (!sendQueryFocuserPosition(&absolutePosition))
         return false;
 
+    return updateFocuserStatus(absolutePosition);
+}
+
+/**
+ * @brief Publish a focuser position read by the mount during its status poll
+ * @param absolutePosition position as reported by the controller
+ */
+bool LX200StarGoFocuser::updateFocuserStatus(int absolutePosition) {
+    FocusAbsPosN[0].value = (focuserReversed == INDI_DISABLED) ? absolutePosition : -absolutePosition;
+    focuserPositionKnown = true;
+    IDSetNumber(&FocusAbsPosNP, nullptr);
+
     if (isFocuserMoving() && atFocuserTargetPosition()) {
         FocusAbsPosNP.s = IPS_OK;
         IDSetNumber(&FocusAbsPosNP, nullptr);
@@ -354,6 +362,16 @@ bool LX200StarGoFocuser::ReadFocuserStatus() {
     return true;
 }
 
+/**
+ * @brief Check whether the position has to be queried in the next status poll
+ * @return true iff the focuser is moving or its position is not known yet
+ */
+bool LX200StarGoFocuser::needsStatusUpdate() {
+    if (!isConnected())
+        return false;
+    return !focuserPositionKnown || isFocuserMoving() || FocusTimerNP.s == IPS_BUSY;
+}
+
 bool LX200StarGoFocuser::SetFocuserSpeed(int speed) {
     return sendNewFocuserSpeed(speed);
 }
@@ -396,6 +414,8 @@ IPState LX200StarGoFocuser::moveFocuserRelative(int relativePosition) {
 
 
 bool LX200StarGoFocuser::AbortFocuser() {
+    // read back where the focuser stopped
+    focuserPositionKnown = false;
     return sendAbortFocuser();
 }
 
@@ -404,6 +424,7 @@ IPState LX200StarGoFocuser::syncFocuser(int absolutePosition) {
     if (!result) {
         return IPS_ALERT;
     }
+    focuserPositionKnown = false;
     return IPS_OK;
 }
 
@@ -430,6 +451,7 @@ const char *LX200StarGoFocuser::getDefaultName()
 bool LX200StarGoFocuser::activate(bool enabled)
 {
     focuserActivated = enabled;
+    focuserPositionKnown = false;
     return updateProperties();
 }
 
@@ -498,6 +520,11 @@ bool LX200StarGoFocuser::sendQueryFocuserPosition(int* position) {
         DEBUGF(INDI::Logger::DBG_ERROR, "%s: Failed to receive AUX1 position response.", getDeviceName());
         return false;
     }
+    return parseFocuserPosition(response, position);
+}
+
+bool LX200StarGoFocuser::parseFocuserPosition(const char *response, int *position) {
+    // Response - AX1=ppppppp#
     int tempPosition = 0;
     int returnCode = sscanf(response, "%*c%*c%*c%*c%07d", &tempPosition);
     if (returnCode <= 0) {
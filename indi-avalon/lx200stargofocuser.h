@@ -37,6 +37,9 @@ public:
     void initProperties(const char *groupName);
     bool updateProperties() override;
     bool ReadFocuserStatus();
+    bool updateFocuserStatus(int absolutePosition);
+    bool needsStatusUpdate();
+    bool parseFocuserPosition(const char *response, int *position);
 
     bool ISNewSwitch(const char *dev, const char *name, ISState *states, char *names[], int n) override;
     bool ISNewNumber(const char *dev, const char *name, double values[], char *names[], int n) override;
@@ -77,6 +80,7 @@ protected:
     bool startMovingFocuserOutward;
     uint32_t moveFocuserDurationRemaining;
     bool focuserActivated;
+    bool focuserPositionKnown = false;
     int focuserReversed = INDI_DISABLED;
 
 
@@ -21,6 +21,7 @@
 #include "unistd.h"
 #include <memory>
 #include <string.h>
+#include <errno.h>
 #include <string>
 #include <unordered_map>
 #include <functional>
@@ -50,66 +51,133 @@ static std::string GetIndiErrorReason( int errorID )
     errorReason.at( errorID );
 } 
 
-bool TCP::DataReady( void ) 
+//================================================================
+
+Interface& Interface::operator<<( char c )
 {
-  if ( Failed() )
+  outBuffer.push_back( c );
+  if ( c == '\n' )
   {
-    return false;
+    Flush();
   }
-  int status = tty_timeout( fd, 0 );
-  if ( status != TTY_OK && status != TTY_TIME_OUT )
+  return *this;
+}
+
+void Interface::Flush( void )
+{
+  if ( !Failed() && !outBuffer.empty() )
   {
-    Fail("Error on DataReady (" + GetIndiErrorReason( status ) +")");
-    return false;
+    Write( outBuffer );
+  }
+  outBuffer.clear();
+}
+
+Interface& Interface::operator>>( char &c )
+{
+  c = 0;
+  while ( !Failed() && inPos >= inBuffer.size() )
+  {
+    Fill( inBuffer, true );
   }
-  return status == TTY_OK;
+  if ( !Failed() )
+  {
+    c = inBuffer[ inPos++ ];
+  }
+  return *this;
 }
 
-Interface& TCP::operator<<( char c ) 
+std::string Interface::GetLine( void )
+{
+  // Don't wait on a reply to a command that is still sitting in the buffer.
+  Flush();
+
+  std::size_t searchFrom = inPos;
+  for ( ;; )
+  {
+    if ( Failed() )
+    {
+      return std::string();
+    }
+    std::size_t eol = inBuffer.find( '\n', searchFrom );
+    if ( eol != std::string::npos )
+    {
+      std::string rval = inBuffer.substr( inPos, eol - inPos );
+      inPos = eol + 1;
+      if ( inPos == inBuffer.size() )
+      {
+        inBuffer.clear();
+        inPos = 0;
+      }
+      return rval;
+    }
+    searchFrom = inBuffer.size();
+    Fill( inBuffer, true );
+  }
+}
+
+bool Interface::DataReady( void )
 {
   if ( Failed() )
   {
-    return *this;
+    return false;
+  }
+  if ( inPos < inBuffer.size() )
+  {
+    return true;
   }
+  inBuffer.clear();
+  inPos = 0;
+  return Fill( inBuffer, false );
+}
 
+//================================================================
+
+void TCP::Write( const std::string& data )
+{
   // tty_write will output data until it succeeds or fails.
   int nbytes_written = 0;
-  int status = tty_write( fd, &c, 1, &nbytes_written );
+  int status = tty_write( fd, data.data(), data.size(), &nbytes_written );
 
   if ( status != TTY_OK )
   {
     Fail("Error on Write (" + GetIndiErrorReason( status ) +")");
   }
-  else if ( nbytes_written != 1 ) 
+  else if ( nbytes_written != (int) data.size() ) 
   {
     // Should never happen.
-    Fail("tty_write wrote 0 bytes, expected 1");
+    Fail("tty_write wrote " + std::to_string( nbytes_written ) +
+         " bytes, expected " + std::to_string( data.size() ));
   }
-
-  return *this;
 }
 
-Interface& TCP::operator>>(char &c )
+bool TCP::Fill( std::string& input, bool wait )
 {
-  c = 0;
-  if ( Failed() )
+  int status = tty_timeout( fd, wait ? GetTimeout() : 0 );
+  if ( status == TTY_TIME_OUT && !wait )
   {
-    return *this;
+    return false;
   }
-
-  int nbytes_read = 0;
-  int status = tty_read( fd, &c, 1, GetTimeout(), &nbytes_read );
-
   if ( status != TTY_OK )
   {
     Fail( "Error on Read (" + GetIndiErrorReason( status ) +")" );
+    return false;
   }
-  else if ( nbytes_read == 0 )
+
+  // Take everything the socket has in one go.
+  char buffer[ 512 ];
+  ssize_t nbytes_read = read( fd, buffer, sizeof( buffer ));
+  if ( nbytes_read < 0 )
   {
-    // Should never happen.
-    Fail( "Error on Read - Expected 1 byte, got 0" );
+    Fail( std::string( "Error on Read (" ) + strerror( errno ) + ")" );
+    return false;
   }
-  return *this;
+  if ( nbytes_read == 0 )
+  {
+    Fail( "Error on Read - Connection closed" );
+    return false;
+  }
+  input.append( buffer, nbytes_read );
+  return true;
 }
 
 int TCP::GetTimeout( void )
@@ -119,13 +187,15 @@ int TCP::GetTimeout( void )
 
 //================================================================
 
-Interface& Sim::operator<<( char c )
+void Sim::Write( const std::string& data )
 {
-  toFirmware.push(c);
-  return *this;
+  for ( char c : data )
+  {
+    toFirmware.push(c);
+  }
 }
 
-Interface& Sim::operator>>( char &c )
+bool Sim::Fill( std::string& input, bool wait )
 {
   // Handle an empty input by erroring out...
   // This doesn't match reality - in reality we'd block until the other
@@ -138,45 +208,26 @@ Interface& Sim::operator>>( char &c )
 
   if ( fromFirmware.empty() )
   {
-    Fail( "Read called when mock queue was empty" );
-  }
-  c = fromFirmware.front();
-  fromFirmware.pop();
-  return *this;
-}
-
-bool Sim::DataReady()
-{
-  return !fromFirmware.empty();
-}
-
-//================================================================
-
-static std::string GetStringRaw( Interface& con )
-{
-  std::string rval;
-
-  for ( ;; )
-  {
-    char c;
-    con >> c;
-    if ( con.Failed())
+    if ( wait )
     {
-      return std::string();
+      Fail( "Read called when mock queue was empty" );
     }
-    if ( c == '\n' )
-    {
-      break;
-    }
-    rval.push_back(c);
+    return false;
   }
-  return rval;
+  while ( !fromFirmware.empty() )
+  {
+    input.push_back( fromFirmware.front() );
+    fromFirmware.pop();
+  }
+  return true;
 }
 
+//================================================================
+
 std::string GetString( Interface& con )
 {
   std::string rval;
-  rval = GetStringRaw( con );
+  rval = con.GetLine();
   return (con.Failed() || rval.find("#")) == 0 ? std::string() : rval;
 }
 
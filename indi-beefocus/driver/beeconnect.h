@@ -71,6 +71,9 @@ using QueueOfChar = std::queue<char>;
 ///   focuser hardware and a simulated version of the focuser.  The later is
 ///   used for testing.
 /// - Simplify Error handling and reporting.
+/// - Buffer the stream in both directions.  Output is held until a
+///   command is complete (a newline) and then sent with one write.  Input
+///   is read in bulk and handed out a line at a time.
 ///   
 class Interface
 {
@@ -78,10 +81,13 @@ class Interface
 
   Interface() : 
     isFailed { false },
-    conStatus { "Connected" }
+    conStatus { "Connected" },
+    inPos { 0 }
   {
   }
 
+  virtual ~Interface() = default;
+
   /// @brief Has the connection errored out?
   bool Failed( void ) const { return isFailed; }
 
@@ -95,21 +101,60 @@ class Interface
   /// @brief User friendly connection status.
   virtual std::string GetStatus( void ) const { return conStatus; }
 
+  ///
   /// @brief Output a character to the connection.
-  virtual Interface& operator<<( char c ) = 0;
+  ///
+  /// The character is buffered.  A newline completes the command and
+  /// flushes the buffer.
+  ///
+  Interface& operator<<( char c );
+
+  /// @brief Send any buffered output now.
+  void Flush( void );
 
   /// @brief Input a character from the connection.
-  virtual Interface& operator>>( char &c ) = 0; 
+  Interface& operator>>( char &c ); 
+
+  ///
+  /// @brief Blocking call to get a line from the connection.
+  ///
+  /// @return The line, without the newline.
+  ///
+  /// If the connection fails an empty string is returned.
+  ///
+  std::string GetLine( void );
 
   /// @brief Are there characters ready to be read?
-  virtual bool DataReady() = 0;
+  bool DataReady();
 
   protected:
 
+  ///
+  /// @brief Send a block of characters down the connection.
+  ///
+  /// Fails the connection on error.
+  ///
+  virtual void Write( const std::string& data ) = 0;
+
+  ///
+  /// @brief Append whatever input is available to the input buffer.
+  ///
+  /// @param[in] wait   If true block (up to a timeout) for input.  If 
+  ///                   false only take what is already there.
+  /// @return           True if any characters were added.
+  ///
+  /// A timeout while waiting fails the connection.
+  ///
+  virtual bool Fill( std::string& input, bool wait ) = 0;
+
   bool isFailed;
   std::string conStatus;
 
   private:
+
+  std::string outBuffer;
+  std::string inBuffer;
+  std::size_t inPos;
 };
 
 ///
@@ -137,14 +182,10 @@ class TCP: public Interface
   TCP( const TCP& ) = delete;
   TCP& operator=( const TCP& ) = delete;
 
-  /// @brief Output a character to the connection.
-  Interface& operator<<( char c ) override; 
-
-  /// @brief Input a character from the connection.
-  Interface& operator>>( char &c ) override; 
+  protected:
 
-  /// @brief Are there characters ready to be read?
-  bool DataReady(void) override;
+  void Write( const std::string& data ) override;
+  bool Fill( std::string& input, bool wait ) override;
 
   private:
 
@@ -177,20 +218,15 @@ class Sim: public Interface
   Sim( const Sim& ) = delete;
   Sim& operator=( const Sim& ) = delete;
 
-  /// @brief Output a character to the connection.
-  Interface& operator<<( char c ) override; 
-
-  /// @brief Input a character from the connection.
-  Interface& operator>>( char &c ) override; 
+  protected:
 
-  /// @brief Are there characters ready to be read?
-  bool DataReady(void) override;
+  void Write( const std::string& data ) override;
+  bool Fill( std::string& input, bool wait ) override;
 
   private:
 
   std::queue<char>& toFirmware;
   std::queue<char>& fromFirmware;
-  std::string outputString;
 };
 
 ///
@@ -33,8 +33,7 @@ void DsiColorIII::initImager(const char *devname)
      */
     for (int i = 0; i < 1; i++)
     {
-        unsigned char *foo = getImage(1);
-        delete[] foo;
+        getImage(1);
     }
 }
 
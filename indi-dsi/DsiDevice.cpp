@@ -13,9 +13,11 @@
 #include "DsiException.h"
 #include "Util.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <math.h>
 #include <memory>
 #include <unistd.h>
@@ -29,8 +31,17 @@
 #define MILLISEC 2
 #endif
 
+/* EEPROM region holding the serial number, CCD chip name and camera name. */
+#define EEPROM_CACHE_SIZE 0x3c
+
 static unsigned int last_time;
 
+/* EEPROM images of the devices opened so far, by USB bus and address.  The
+ * DeviceFactory opens every camera twice, and reading the EEPROM costs one
+ * command round trip per byte. */
+static std::map<std::pair<int, int>, std::vector<unsigned char>> eeprom_images;
+static unsigned int eeprom_reads;
+
 static unsigned int get_sysclock_ms()
 {
     struct timeval tv;
@@ -125,7 +136,8 @@ DSI::Device::Device(const char *devname) : readout_mode(ReadoutMode::DUAL), usb_
     image_offset_x          = 0;
     image_offset_y          = 0;
 
-    framebuffer = (unsigned char *)0;
+    framebuffer        = (unsigned char *)0;
+    buffer_allocations = 0;
 
     binning2x2 = false;
     ccd_temp   = -128.5;
@@ -329,6 +341,8 @@ void DSI::Device::initImager(const char *devname)
 
     command(DeviceCommand::GET_READOUT_MODE);
 
+    loadEeprom();
+
     /* I thought this is what the Meade driver was doing but, while it
        appears to be retrieving EEPROM data, it is not this region of the
        EEPROM.  */
@@ -477,11 +491,14 @@ unsigned int DSI::Device::getEepromLength()
  */
 unsigned char DSI::Device::getEepromByte(int __offset)
 {
+    eeprom_reads++;
     return command(DeviceCommand::GET_EEPROM_BYTE, __offset);
 }
 
 unsigned char DSI::Device::setEepromByte(unsigned char __val, int __offset)
 {
+    if (__offset >= 0 && __offset < (int)eeprom.size())
+        eeprom[__offset] = __val;
     return command(DeviceCommand::SET_EEPROM_BYTE, __offset | (__val << 8));
 }
 
@@ -491,6 +508,36 @@ void DSI::Device::setEepromData(unsigned char *__buffer, int __offset, int __len
     {
         setEepromByte(__buffer[i], __offset + i);
     }
+    eeprom_images[std::make_pair(libusb_get_bus_number(dev), libusb_get_device_address(dev))] = eeprom;
+}
+
+/**
+ * Read the identification region of the EEPROM into the cache, unless this
+ * device has been read before.  getEepromData() serves that region from the
+ * cache afterwards.
+ */
+void DSI::Device::loadEeprom()
+{
+    std::pair<int, int> key(libusb_get_bus_number(dev), libusb_get_device_address(dev));
+    auto image = eeprom_images.find(key);
+    if (image != eeprom_images.end())
+    {
+        eeprom = image->second;
+        return;
+    }
+
+    eeprom.resize(std::min(getEepromLength(), (unsigned int)EEPROM_CACHE_SIZE));
+    for (size_t i = 0; i < eeprom.size(); i++)
+        eeprom[i] = getEepromByte(i);
+    eeprom_images[key] = eeprom;
+}
+
+/**
+ * Number of EEPROM bytes read from all devices so far.
+ */
+unsigned int DSI::Device::getEepromReads()
+{
+    return eeprom_reads;
 }
 
 /**
@@ -509,13 +556,17 @@ void DSI::Device::setEepromData(unsigned char *__buffer, int __offset, int __len
  */
 unsigned char *DSI::Device::getEepromData(int __offset, int __length)
 {
-    int eepromLength      = getEepromLength();
     unsigned char *buffer = new unsigned char[__length];
-    for (int i = 0; i < __length; i++)
+    for (int i = 0; i < __length; i++, __offset++)
     {
-        if (__offset >= eepromLength)
+        if (__offset < (int)eeprom.size())
+        {
+            buffer[i] = eeprom[__offset];
+            continue;
+        }
+        if (__offset >= (int)getEepromLength())
             return buffer;
-        buffer[i] = getEepromByte(__offset++);
+        buffer[i] = getEepromByte(__offset);
     }
     return buffer;
 }
@@ -853,13 +904,9 @@ unsigned char *DSI::Device::downloadImage()
     unsigned int odd_size  = t_read_bpp * t_read_width * t_read_height_odd;
     unsigned int even_size = t_read_bpp * t_read_width * t_read_height_even;
     unsigned int all_size  = t_read_bpp * t_read_width * t_read_height;
-    unsigned char *odd_data = new unsigned char[odd_size];
-    unsigned char *even_data = nullptr;
-
-    if (interlaced)
-        even_data = new unsigned char[even_size];
-
-    framebuffer = new unsigned char[all_size];
+    prepareBuffers(odd_size, interlaced ? even_size : 0, all_size);
+    unsigned char *odd_data  = odd_buffer.data();
+    unsigned char *even_data = interlaced ? even_buffer.data() : nullptr;
 
     if (interlaced)
     {
@@ -1010,11 +1057,6 @@ unsigned char *DSI::Device::downloadImage()
     if (log_commands)
         std::cerr << "write_ptr=" << write_ptr << std::endl;
 
-    delete[] odd_data;
-
-    if (interlaced)
-        delete[] even_data;
-
     return framebuffer;
 
     throw dsi_exception("unsupported image command");
@@ -1050,6 +1092,26 @@ unsigned char *DSI::Device::ccdFramebuffer()
     return (framebuffer);
 }
 
+/**
+ * Size the readout buffers for the current readout geometry.  The buffers are
+ * kept between readouts, so they are only reallocated when a readout needs
+ * more memory than any earlier one.  framebuffer stays valid until the next
+ * readout.
+ */
+void DSI::Device::prepareBuffers(unsigned int odd_size, unsigned int even_size, unsigned int all_size)
+{
+    std::vector<unsigned char> *buffers[] = { &odd_buffer, &even_buffer, &frame_buffer };
+    unsigned int sizes[] = { odd_size, even_size, all_size };
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (buffers[i]->capacity() < sizes[i])
+            buffer_allocations++;
+        buffers[i]->resize(sizes[i]);
+    }
+    framebuffer = frame_buffer.data();
+}
+
 void DSI::Device::set1x1Binning()
 {
     binning2x2 = false;
@@ -1299,13 +1361,9 @@ unsigned char *DSI::Device::getImage(DeviceCommand __command, int howlong)
         unsigned int odd_size  = t_read_bpp * t_read_width * t_read_height_odd;
         unsigned int even_size = t_read_bpp * t_read_width * t_read_height_even;
         unsigned int all_size  = t_read_bpp * t_read_width * t_read_height;
-        unsigned char *odd_data = new unsigned char[odd_size];
-        unsigned char *even_data = nullptr;
-
-        if (interlaced)
-            even_data = new unsigned char[even_size];
-
-        framebuffer = new unsigned char[all_size];
+        prepareBuffers(odd_size, interlaced ? even_size : 0, all_size);
+        unsigned char *odd_data  = odd_buffer.data();
+        unsigned char *even_data = interlaced ? even_buffer.data() : nullptr;
 
         /* The Meade driver seems to only issue a GET_EXP_TIME_COUNT command
          * when the exposure is over about 2 seconds (count = 20,000).  From
@@ -1444,11 +1502,6 @@ unsigned char *DSI::Device::getImage(DeviceCommand __command, int howlong)
         if (log_commands)
             std::cerr << "write_ptr=" << write_ptr << std::endl;
 
-        delete[] odd_data;
-
-        if (interlaced)
-            delete[] even_data;
-
         return framebuffer;
     }
 
@@ -11,6 +11,7 @@
 #include <libusb-1.0/libusb.h>
 
 #include <string>
+#include <vector>
 
 #ifndef LONGEXP
 #define LONGEXP 20000
@@ -30,9 +31,18 @@ class Device
     std::string camera_name;
 
   protected:
-    /* image frame buffer (gs) */
+    /* image frame buffer (gs), points into frame_buffer */
     unsigned char *framebuffer;
 
+    /* Readout buffers, reused as long as the readout geometry fits. */
+    std::vector<unsigned char> odd_buffer;
+    std::vector<unsigned char> even_buffer;
+    std::vector<unsigned char> frame_buffer;
+    unsigned int buffer_allocations;
+
+    /* Identification region of the EEPROM, read once when the device opens. */
+    std::vector<unsigned char> eeprom;
+
     /* These are chip-specific sizes required to parameterize the image
          * retrieval.
          */
@@ -136,6 +146,7 @@ class Device
     void loadVersion();
     void loadEepromLength();
     void loadCameraName();
+    void loadEeprom();
 
     virtual ReadoutMode getReadoutMode();
     virtual void setReadoutMode(DSI::ReadoutMode rm);
@@ -176,6 +187,7 @@ class Device
     virtual unsigned char *getImage(DeviceCommand __command, int howlong);
 
     void sendRegister(AdRegister adr, unsigned int arg);
+    void prepareBuffers(unsigned int odd_size, unsigned int even_size, unsigned int all_size);
 
   public:
     Device(const char *devname = 0);
@@ -213,6 +225,8 @@ class Device
     virtual int startExposure(int howlong, int gain = 0, int offs = 0x0ff);
     virtual int ExposureInProgress();
     virtual unsigned char *ccdFramebuffer();
+    unsigned int getBufferAllocations() { return buffer_allocations; }
+    static unsigned int getEepromReads();
 
     virtual void set1x1Binning();
     virtual void set2x2Binning();
@@ -23,6 +23,7 @@
 #include "config.h"
 #include "DsiDeviceFactory.h"
 
+#include <chrono>
 #include <iostream>
 #include <math.h>
 #include <arpa/inet.h>
@@ -74,6 +75,8 @@ DSICCD::DSICCD()
     capturing  = false;
     dsi        = nullptr;
 
+    bufferAllocations = 0;
+
     setVersion(DSI_VERSION_MAJOR, DSI_VERSION_MINOR);
 }
 
@@ -84,6 +87,8 @@ bool DSICCD::Connect()
 {
     uint32_t cap = 0;
     std::string ccd;
+    auto start               = std::chrono::steady_clock::now();
+    unsigned int eepromReads = DSI::Device::getEepromReads();
 
     dsi = DSI::DeviceFactory::getInstance(nullptr);
 #ifdef __APPLE__
@@ -149,6 +154,11 @@ bool DSICCD::Connect()
         IDSetNumber(&CCDTempNP, nullptr);
     }
 
+    bufferAllocations = dsi->getBufferAllocations();
+    LOGF_INFO("Connected in %.0f ms, %u EEPROM bytes read.",
+              std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+              DSI::Device::getEepromReads() - eepromReads);
+
     return true;
 }
 
@@ -530,6 +540,9 @@ void DSICCD::grabImage()
     }
     guard.unlock();
 
+    LOGF_DEBUG("Readout buffer allocations for this frame: %u", dsi->getBufferAllocations() - bufferAllocations);
+    bufferAllocations = dsi->getBufferAllocations();
+
     for (y = 0; y < height; ++y)
     {
         for (x = 0; x < width; ++x)
@@ -538,8 +551,6 @@ void DSICCD::grabImage()
         }
     }
 
-    delete buf;
-
     // Let INDI::CCD know we're done filling the image buffer
     ExposureComplete(&PrimaryCCD);
 
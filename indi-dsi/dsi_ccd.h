@@ -66,6 +66,9 @@ class DSICCD : public INDI::CCD
 
     float ExposureRequest;
 
+    // Readout buffer allocations up to the previous frame
+    unsigned int bufferAllocations;
+
     INumber GainN[1];
     INumberVectorProperty GainNP;
 
@@ -0,0 +1,157 @@
+/*
+   Firmata C++ library.
+*/
+
+#include <iostream>
+#include <stdlib.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <firmata.h>
+
+/*
+Measure connect time and command latency against a fake Firmata board
+running on the other end of a pseudo terminal, no hardware needed.
+The fake board announces the given number of digital pins (default 70,
+as an Arduino Mega).
+*/
+
+static void fake_board(int fd, int npins)
+{
+    uint8_t mode[128] = {0};
+    uint8_t msg[256];
+    int len = 0, want = 0;
+
+    while (true)
+    {
+        uint8_t c;
+        if (read(fd, &c, 1) != 1)
+        {
+            usleep(1000);
+            continue;
+        }
+        if (c == FIRMATA_START_SYSEX)
+        {
+            len  = 0;
+            want = sizeof(msg);
+        }
+        else if (c == FIRMATA_SET_PIN_MODE || (c & 0xF0) == FIRMATA_DIGITAL_MESSAGE || (c & 0xF0) == FIRMATA_ANALOG_MESSAGE)
+        {
+            len  = 0;
+            want = 3;
+        }
+        else if ((c & 0xF0) == FIRMATA_REPORT_ANALOG || (c & 0xF0) == FIRMATA_REPORT_DIGITAL)
+        {
+            len  = 0;
+            want = 2;
+        }
+        if (len < (int)sizeof(msg))
+            msg[len++] = c;
+        if (c == FIRMATA_END_SYSEX)
+            want = len;
+        if (len != want)
+            continue;
+
+        std::string reply;
+        if (msg[0] == FIRMATA_SET_PIN_MODE && msg[1] < 128)
+            mode[msg[1]] = msg[2];
+        else if (msg[0] == FIRMATA_START_SYSEX && msg[1] == FIRMATA_REPORT_FIRMWARE)
+        {
+            const char *name = "FakeFirmata";
+            reply = { (char)FIRMATA_START_SYSEX, (char)FIRMATA_REPORT_FIRMWARE, 2, 5 };
+            for (const char *p = name; *p; p++)
+            {
+                reply += (char)(*p & 0x7F);
+                reply += (char)0;
+            }
+            reply += (char)FIRMATA_END_SYSEX;
+        }
+        else if (msg[0] == FIRMATA_START_SYSEX && msg[1] == FIRMATA_CAPABILITY_QUERY)
+        {
+            reply = { (char)FIRMATA_START_SYSEX, (char)FIRMATA_CAPABILITY_RESPONSE };
+            for (int pin = 0; pin < npins; pin++)
+                reply += std::string({ FIRMATA_MODE_INPUT, 1, FIRMATA_MODE_OUTPUT, 1, 127 });
+            reply += (char)FIRMATA_END_SYSEX;
+        }
+        else if (msg[0] == FIRMATA_START_SYSEX && msg[1] == FIRMATA_ANALOG_MAPPING_QUERY)
+        {
+            reply = { (char)FIRMATA_START_SYSEX, (char)FIRMATA_ANALOG_MAPPING_RESPONSE };
+            reply += std::string(npins, 127);
+            reply += (char)FIRMATA_END_SYSEX;
+        }
+        else if (msg[0] == FIRMATA_START_SYSEX && msg[1] == FIRMATA_PIN_STATE_QUERY && msg[2] < npins)
+        {
+            reply = { (char)FIRMATA_START_SYSEX, (char)FIRMATA_PIN_STATE_RESPONSE, (char)msg[2], (char)mode[msg[2]], 0,
+                      (char)FIRMATA_END_SYSEX
+                    };
+        }
+        if (!reply.empty() && write(fd, reply.data(), reply.size()) < 0)
+            exit(1);
+        len = want = 0;
+    }
+}
+
+static double elapsed_ms(const struct timeval &start)
+{
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    return (now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_usec - start.tv_usec) / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+    int npins = argc > 1 ? atoi(argv[1]) : 70;
+    if (npins <= 0 || npins > 127)
+    {
+        fprintf(stderr, "Usage: fake_board_timing [number of pins (1-127)]\n");
+        exit(1);
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0)
+    {
+        perror("posix_openpt");
+        exit(1);
+    }
+    struct termios raw;
+    tcgetattr(master, &raw);
+    cfmakeraw(&raw);
+    tcsetattr(master, TCSANOW, &raw);
+
+    pid_t board = fork();
+    if (board == 0)
+    {
+        fake_board(master, npins);
+        exit(0);
+    }
+
+    struct timeval start;
+    gettimeofday(&start, nullptr);
+    Firmata *sf = new Firmata(ptsname(master));
+    if (!sf->portOpen)
+    {
+        fprintf(stderr, "Handshake with the fake board failed\n");
+        kill(board, SIGTERM);
+        exit(1);
+    }
+    printf("Handshake: %.1f ms\n", elapsed_ms(start));
+
+    gettimeofday(&start, nullptr);
+    sf->initState();
+    printf("initState (%d pins): %.1f ms\n", npins, elapsed_ms(start));
+
+    const int rounds = 100;
+    gettimeofday(&start, nullptr);
+    for (int i = 0; i < rounds; i++)
+        sf->setPinMode(13, i % 2 ? FIRMATA_MODE_INPUT : FIRMATA_MODE_OUTPUT);
+    printf("setPinMode round trip: %.2f ms\n", elapsed_ms(start) / rounds);
+
+    gettimeofday(&start, nullptr);
+    for (int i = 0; i < rounds; i++)
+        sf->writeDigitalPin(13, i % 2 ? ARDUINO_HIGH : ARDUINO_LOW);
+    printf("writeDigitalPin: %.3f ms\n", elapsed_ms(start) / rounds);
+
+    delete sf;
+    kill(board, SIGTERM);
+    waitpid(board, nullptr, 0);
+    return 0;
+}
@@ -50,31 +50,47 @@ int Arduino::destroy()
 }
 
 int Arduino::sendUchar(const unsigned char data)
+{
+    return sendBuffer(&data, 1);
+}
+
+// Whole messages are written with a single write(), the port is non-blocking
+// so a full output queue is waited out with select().
+int Arduino::sendBuffer(const unsigned char *data, size_t len)
 {
 #ifdef DEBUG
-    LOGF_DEBUG("Arduino::sendUchar sending: 0x%02x", data);
+    for (size_t i = 0; i < len; i++)
+        LOGF_DEBUG("Arduino::sendBuffer sending: 0x%02x", data[i]);
 #endif // DEBUG
-    if (write(fd, &data, sizeof(char)) < 0)
+    size_t sent = 0;
+    while (sent < len)
     {
-        LOGF_DEBUG("Arduino::sendUchar():write():%s", strerror(errno));
-        LOGF_DEBUG("during write 0x%02x (%c)", data, data);
-        return (-1);
+        ssize_t n = write(fd, data + sent, len - sent);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN)
+            {
+                fd_set wfds;
+                struct timeval tv = { 1, 0 };
+                FD_ZERO(&wfds);
+                FD_SET(fd, &wfds);
+                if (select(fd + 1, nullptr, &wfds, nullptr, &tv) > 0)
+                    continue;
+            }
+            LOGF_DEBUG("Arduino::sendBuffer():write():%s", strerror(errno));
+            LOGF_DEBUG("during write of %u bytes (0x%02x...)", static_cast<unsigned>(len), data[0]);
+            return (-1);
+        }
+        sent += n;
     }
-    usleep(100);
     return (0);
 }
+
 int Arduino::sendString(const string datastr)
 {
-    int rv = 0;
-    for (int i = 0; i < datastr.size(); i++)
-    {
-        unsigned char data = (unsigned char)datastr[i];
-#ifdef DEBUG
-        LOGF_DEBUG("Arduino::sendString sending: %01x", data);
-#endif // DEBUG
-        rv |= sendUchar(data);
-    }
-    return (rv);
+    return sendBuffer(reinterpret_cast<const unsigned char *>(datastr.data()), datastr.size());
 }
 
 int Arduino::readPort(void *buff, int count)
@@ -43,6 +43,7 @@ class Arduino
     ~Arduino();
     int destroy();
     int sendUchar(const unsigned char);
+    int sendBuffer(const unsigned char *data, size_t len);
     int sendString(const string);
     int readPort(void *buff, int count);
     int openPort(const char *_serialPort);
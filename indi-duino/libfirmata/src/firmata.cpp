@@ -14,6 +14,7 @@
 #include <firmata.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
 
 void (*firmata_debug_cb)(const char *file, int line, const char *msg, ...) = NULL;
 
@@ -80,8 +81,11 @@ int Firmata::writeDigitalPin(unsigned char pin, unsigned char mode)
 
     if (port < 0) return port;
 
-    rv |= arduino->sendUchar(FIRMATA_DIGITAL_MESSAGE + port);
-    rv |= sendValueAsTwo7bitBytes(digitalPortValue[port]); //ARDUINO_HIGH OR ARDUINO_LOW
+    unsigned char msg[3] = { static_cast<unsigned char>(FIRMATA_DIGITAL_MESSAGE + port),
+                             static_cast<unsigned char>(digitalPortValue[port] & 127),     // LSB
+                             static_cast<unsigned char>(digitalPortValue[port] >> 7 & 127) // MSB
+                           };
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     LOGF_DEBUG("Sending DIGITAL_MESSAGE pin:%d, mode:%d, port:%d, port_val:%02X", pin, mode, port, digitalPortValue[port]);
     return (rv);
 }
@@ -90,20 +94,20 @@ int Firmata::writeDigitalPin(unsigned char pin, unsigned char mode)
 // therefore you need two data bytes to send 8-bits (a char).
 int Firmata::sendValueAsTwo7bitBytes(int value)
 {
-    int rv = 0;
-    rv |= arduino->sendUchar(value & 127);      // LSB
-    rv |= arduino->sendUchar(value >> 7 & 127); // MSB
-    return rv;
+    unsigned char msg[2] = { static_cast<unsigned char>(value & 127),     // LSB
+                             static_cast<unsigned char>(value >> 7 & 127) // MSB
+                           };
+    return arduino->sendBuffer(msg, sizeof(msg));
 }
 
 int Firmata::setSamplingInterval(int16_t value)
 {
     int rv = 0;
-    rv |= arduino->sendUchar(FIRMATA_START_SYSEX);
-    rv |= arduino->sendUchar(FIRMATA_SAMPLING_INTERVAL);
-    rv |= arduino->sendUchar((unsigned char)(value % 128));
-    rv |= arduino->sendUchar((unsigned char)(value >> 7));
-    rv |= arduino->sendUchar(FIRMATA_END_SYSEX);
+    unsigned char msg[5] = { FIRMATA_START_SYSEX, FIRMATA_SAMPLING_INTERVAL,
+                             (unsigned char)(value % 128), (unsigned char)(value >> 7),
+                             FIRMATA_END_SYSEX
+                           };
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     LOGF_DEBUG("Sending SAMPLING_INTERVAL value:%d", value);
     return (rv);
 }
@@ -111,11 +115,9 @@ int Firmata::setSamplingInterval(int16_t value)
 int Firmata::setPinMode(unsigned char pin, unsigned char mode)
 {
     int rv = 0;
-    rv |= arduino->sendUchar(FIRMATA_SET_PIN_MODE);
-    rv |= arduino->sendUchar(pin);
-    rv |= arduino->sendUchar(mode);
+    unsigned char msg[3] = { FIRMATA_SET_PIN_MODE, pin, mode };
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     LOGF_DEBUG("Sending SET_PIN_MODE pin:%d, mode:%d", pin, mode);
-    usleep(1000);
     rv |= askPinStateWaitForReply(pin);
     return (rv);
 }
@@ -126,33 +128,33 @@ int Firmata::setPwmPin(unsigned char pin, uint16_t value)
     if ((pin <= 0xf) && (value <= 0x3fff))
     {
         LOGF_DEBUG("Sending ANALOG_MESSAGE pin:%d, value:%d", pin, value);
-        rv |= arduino->sendUchar(FIRMATA_ANALOG_MESSAGE + pin);
-        rv |= arduino->sendUchar((unsigned char)(value % 128));
-        rv |= arduino->sendUchar((unsigned char)(value >> 7));
+        unsigned char msg[3] = { (unsigned char)(FIRMATA_ANALOG_MESSAGE + pin),
+                                 (unsigned char)(value % 128), (unsigned char)(value >> 7)
+                               };
+        rv |= arduino->sendBuffer(msg, sizeof(msg));
     }
     else
     {
         LOGF_DEBUG("Sending EXTENDED_ANALOG pin:%d, value:%lu", pin, value);
-        rv |= arduino->sendUchar(FIRMATA_START_SYSEX);
-        rv |= arduino->sendUchar(FIRMATA_EXTENDED_ANALOG);
-        rv |= arduino->sendUchar(pin & 0x7f);
-         rv |= arduino->sendUchar(value & 0x7f);
-         value >>= 7;
-         while (value)
-         {
-             rv |= arduino->sendUchar(value & 0x7f);
-             value >>= 7;
-         }
-         rv |= arduino->sendUchar(FIRMATA_END_SYSEX);
+        unsigned char msg[8] = { FIRMATA_START_SYSEX, FIRMATA_EXTENDED_ANALOG, (unsigned char)(pin & 0x7f) };
+        size_t len = 3;
+        msg[len++] = value & 0x7f;
+        value >>= 7;
+        while (value)
+        {
+            msg[len++] = value & 0x7f;
+            value >>= 7;
+        }
+        msg[len++] = FIRMATA_END_SYSEX;
+        rv |= arduino->sendBuffer(msg, len);
     }
     return (rv);
 }
 int Firmata::mapAnalogChannels()
 {
     int rv = 0;
-    rv |= arduino->sendUchar(FIRMATA_START_SYSEX);
-    rv |= arduino->sendUchar(FIRMATA_ANALOG_MAPPING_QUERY); // read firmata name & version
-    rv |= arduino->sendUchar(FIRMATA_END_SYSEX);
+    unsigned char msg[3] = { FIRMATA_START_SYSEX, FIRMATA_ANALOG_MAPPING_QUERY, FIRMATA_END_SYSEX };
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     LOG_DEBUG("Sending ANALOG_MAPPING_QUERY");
     return (rv);
 }
@@ -160,9 +162,8 @@ int Firmata::mapAnalogChannels()
 int Firmata::askFirmwareVersion()
 {
     int rv = 0;
-    rv |= arduino->sendUchar(FIRMATA_START_SYSEX);
-    rv |= arduino->sendUchar(FIRMATA_REPORT_FIRMWARE); // read firmata name & version
-    rv |= arduino->sendUchar(FIRMATA_END_SYSEX);
+    unsigned char msg[3] = { FIRMATA_START_SYSEX, FIRMATA_REPORT_FIRMWARE, FIRMATA_END_SYSEX };
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     LOG_DEBUG("Sending REPORT_FIRMWARE");
     return (rv);
 }
@@ -170,9 +171,8 @@ int Firmata::askFirmwareVersion()
 int Firmata::askCapabilities()
 {
     int rv = 0;
-    rv |= arduino->sendUchar(FIRMATA_START_SYSEX);
-    rv |= arduino->sendUchar(FIRMATA_CAPABILITY_QUERY);
-    rv |= arduino->sendUchar(FIRMATA_END_SYSEX);
+    unsigned char msg[3] = { FIRMATA_START_SYSEX, FIRMATA_CAPABILITY_QUERY, FIRMATA_END_SYSEX };
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     LOG_DEBUG("Sending CAPABILITY_QUERY");
     return (rv);
 }
@@ -180,37 +180,43 @@ int Firmata::askCapabilities()
 int Firmata::askPinState(int pin)
 {
     int rv = 0;
-    rv |= arduino->sendUchar(FIRMATA_START_SYSEX);
-    rv |= arduino->sendUchar(FIRMATA_PIN_STATE_QUERY);
-    rv |= arduino->sendUchar(pin);
-    rv |= arduino->sendUchar(FIRMATA_END_SYSEX);
-    LOGF_DEBUG("Sending PIN_STATE_QUERY pin:%d", pin);
-    rv |= usleep(1000);
+    rv |= sendPinStateQuery(pin);
     rv |= OnIdle();
     return (rv);
 }
 
+int Firmata::sendPinStateQuery(int pin)
+{
+    unsigned char msg[4] = { FIRMATA_START_SYSEX, FIRMATA_PIN_STATE_QUERY, (unsigned char)pin, FIRMATA_END_SYSEX };
+    LOGF_DEBUG("Sending PIN_STATE_QUERY pin:%d", pin);
+    return arduino->sendBuffer(msg, sizeof(msg));
+}
+
 int Firmata::reportDigitalPorts(int enable)
 {
     int rv = 0;
+    unsigned char msg[32];
     for (int i = 0; i < 16; i++)
     {
-        rv |= arduino->sendUchar(FIRMATA_REPORT_DIGITAL | i); // report analog
-        rv |= arduino->sendUchar(enable);
+        msg[2 * i]     = FIRMATA_REPORT_DIGITAL | i;
+        msg[2 * i + 1] = enable;
         LOGF_DEBUG("Sending REPORT_DIGITAL port:%d, enable:%d", i, enable);
     }
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     return (rv);
 }
 
 int Firmata::reportAnalogPorts(int enable)
 {
     int rv = 0;
+    unsigned char msg[32];
     for (int i = 0; i < 16; i++)
     {
-        rv |= arduino->sendUchar(FIRMATA_REPORT_ANALOG | i); // report analog
-        rv |= arduino->sendUchar(enable);
+        msg[2 * i]     = FIRMATA_REPORT_ANALOG | i; // report analog
+        msg[2 * i + 1] = enable;
         LOGF_DEBUG("Sending REPORT_ANALOG pin: A%d, enable:%d", i, enable);
     }
+    rv |= arduino->sendBuffer(msg, sizeof(msg));
     return (rv);
 }
 
@@ -247,25 +253,28 @@ int Firmata::sendStringData(char *data)
 {
     //TODO Testting
     int rv = 0;
-    rv |= arduino->sendUchar(FIRMATA_START_SYSEX);
-    rv |= arduino->sendUchar(FIRMATA_STRING_DATA);
-    for (unsigned int i = 0; i < strlen(data); i++)
+    size_t n = strlen(data);
+    vector<unsigned char> msg;
+    msg.reserve(2 * n + 3);
+    msg.push_back(FIRMATA_START_SYSEX);
+    msg.push_back(FIRMATA_STRING_DATA);
+    for (size_t i = 0; i < n; i++)
     {
-        rv |= sendValueAsTwo7bitBytes(data[i]);
+        msg.push_back(data[i] & 127);      // LSB
+        msg.push_back(data[i] >> 7 & 127); // MSB
     }
-    rv |= arduino->sendUchar(FIRMATA_END_SYSEX);
+    msg.push_back(FIRMATA_END_SYSEX);
+    rv |= arduino->sendBuffer(msg.data(), msg.size());
     LOGF_DEBUG("Sending STRING_DATA: %s", data);
     return (rv);
 }
 
 int Firmata::askPinStateWaitForReply(int pin)
 {
-    OnIdle();
     pin_info[pin].mode = 0xff;
-    for (int i = 0; i < 100; i++) { // 1s
-        if (i % 10 == 0) askPinState(pin); // try again every 0.1 second
-        OnIdle(); // 10ms
-        if (pin_info[pin].mode != 0xff) break;
+    for (int i = 0; i < 100 && pin_info[pin].mode == 0xff; i++) { // 1s
+        if (i % 10 == 0) sendPinStateQuery(pin); // try again every 0.1 second
+        OnIdle(); // returns with the reply or after 10ms
     }
     if (pin_info[pin].mode == 0xff) {
         pin_info[pin].mode = FIRMATA_MODE_INPUT;
@@ -339,15 +348,82 @@ int Firmata::initState()
         if (have_analog_mapping) break;
     }
 
+    vector<int> pins;
     for (int pin = 0; pin < 128; pin++)
     {
         if (pin_info[pin].supported_modes == 0) continue;
-        askPinStateWaitForReply(pin);
+        pins.push_back(pin);
     }
+    askPinStatesWaitForReplies(pins);
 
     return 0;
 }
 
+/*
+ * Query the state of all given pins, keeping a few queries in flight instead
+ * of waiting for each reply in turn. The window is kept small so that the
+ * board's serial receive buffer does not overflow while it sends replies.
+ * Pins that do not reply within a second of silence default to INPUT.
+ */
+int Firmata::askPinStatesWaitForReplies(const vector<int> &pins)
+{
+    struct timeval start, now;
+    gettimeofday(&start, nullptr);
+
+    OnIdle();
+    for (size_t i = 0; i < pins.size(); i++)
+        pin_info[pins[i]].mode = 0xff;
+
+    size_t next = 0, answered = 0;
+    vector<int> inflight;
+    for (int idle = 0; idle < 100 && answered < pins.size();) // 1s without replies
+    {
+        while (inflight.size() < static_cast<size_t>(FIRMATA_PIN_STATE_QUERY_WINDOW) && next < pins.size())
+        {
+            sendPinStateQuery(pins[next]);
+            inflight.push_back(pins[next++]);
+        }
+
+        OnIdle(); // up to 10ms
+
+        size_t before = inflight.size();
+        for (size_t i = 0; i < inflight.size();)
+        {
+            if (pin_info[inflight[i]].mode != 0xff)
+            {
+                inflight.erase(inflight.begin() + i);
+                answered++;
+            }
+            else
+                i++;
+        }
+
+        if (inflight.size() < before)
+            idle = 0;
+        else if (++idle % 10 == 0) // try again every 0.1 second
+        {
+            for (size_t i = 0; i < inflight.size(); i++)
+                sendPinStateQuery(inflight[i]);
+        }
+    }
+
+    int rv = 0;
+    for (size_t i = 0; i < pins.size(); i++)
+    {
+        if (pin_info[pins[i]].mode == 0xff)
+        {
+            pin_info[pins[i]].mode = FIRMATA_MODE_INPUT;
+            rv = -1;
+        }
+    }
+
+    gettimeofday(&now, nullptr);
+    LOGF_DEBUG("PIN_STATE_QUERY: %u of %u pins replied in %ld ms", static_cast<unsigned>(answered),
+               static_cast<unsigned>(pins.size()),
+               (now.tv_sec - start.tv_sec) * 1000L + (now.tv_usec - start.tv_usec) / 1000L);
+    return rv;
+}
+
 void Firmata::Parse(const uint8_t *buf, int len)
 {
     const uint8_t *p, *end;
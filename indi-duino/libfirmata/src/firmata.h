@@ -19,6 +19,7 @@
 //#define FIRMATA_DEFAULT_BAUD          115200
 #define FIRMATA_DEFAULT_BAUD          57600
 #define FIRMATA_FIRMWARE_VERSION_SIZE 2 // number of bytes in firmware version
+#define FIRMATA_PIN_STATE_QUERY_WINDOW 8 // pin state queries in flight during initState
 
 // message command bytes (128-255/0x80-0xFF)
 #define FIRMATA_DIGITAL_MESSAGE 0x90 // send data for a digital pin
@@ -111,6 +112,7 @@ class Firmata
     //int getSysExData();
     int sendStringData(char *data);
     int askPinStateWaitForReply(int pin);
+    int askPinStatesWaitForReplies(const vector<int> &pins);
     int initState();
     time_t secondsSinceVersionReply();
     pin_t pin_info[128];
@@ -139,5 +141,6 @@ class Firmata
     int init(int fd);
     int handshake();
     int sendValueAsTwo7bitBytes(int value);
+    int sendPinStateQuery(int pin);
     int updateDigitalPort(unsigned char pin, unsigned char mode); // mode can be ARDUINO_HIGH or ARDUINO_LOW
 };
@@ -1038,10 +1038,8 @@ IPState WeatherRadio::updateWeather()
     if (result == false)
         return IPS_ALERT;
 
-    char *src{new char[n_bytes+1] {0}};
-    // duplicate the buffer since the parser will modify it
-    strncpy(src, data, static_cast<size_t>(n_bytes));
-    result = parseWeatherData(src);
+    // the parser modifies the buffer in place, data is not used afterwards
+    result = parseWeatherData(data);
 
     // result recieved
     LOGF_DEBUG("Reading weather data from Arduino %s", result ? "succeeded." : "failed!");
@@ -1064,11 +1062,20 @@ bool WeatherRadio::parseWeatherData(char *data)
         return false;
     }
 
+    // regular case: known device layout
+    if (bindingsValid && applyBindings(value))
+    {
+        LOG_DEBUG("Parsing weather data succeeded.");
+        return true;
+    }
+
+    ambientTemperatureSensor = findRawSensorProperty(currentSensors.temp_ambient);
+    objectTemperatureSensor  = findRawSensorProperty(currentSensors.temp_object);
+
     JsonIterator deviceIter;
     for (deviceIter = begin(value); deviceIter != end(value); ++deviceIter)
     {
-        char *name {new char[strlen(deviceIter->key)+1] {0}};
-        strncpy(name, deviceIter->key, static_cast<size_t>(strlen(deviceIter->key)));
+        const char *name = deviceIter->key;
 
         JsonIterator sensorIter;
         INumberVectorProperty *deviceProp = findRawDeviceProperty(name);
@@ -1139,11 +1146,101 @@ bool WeatherRadio::parseWeatherData(char *data)
         }
 
     }
+    // device layout changed, resolve the bindings for the next update
+    updateBindings(value);
+
     LOG_DEBUG("Parsing weather data succeeded.");
     return true;
 
 }
 
+/**************************************************************************************
+** Resolve sensor bindings
+***************************************************************************************/
+void WeatherRadio::updateBindings(JsonValue &value)
+{
+    bindings.clear();
+    bindingsValid = true;
+
+    for (JsonIterator deviceIter = begin(value); deviceIter != end(value); ++deviceIter)
+    {
+        device_binding device;
+        device.key      = deviceIter->key;
+        device.property = findRawDeviceProperty(deviceIter->key);
+        // uninitialized devices need the full parsing until their property exists
+        if (device.property == nullptr)
+            bindingsValid = false;
+
+        for (JsonIterator sensorIter = begin(deviceIter->value); sensorIter != end(deviceIter->value); ++sensorIter)
+        {
+            if (strcmp(sensorIter->key, "init") == 0 || sensorIter->value.getTag() != JSON_NUMBER)
+                continue;
+
+            sensor_binding sensor;
+            sensor.key    = sensorIter->key;
+            sensor.number = device.property != nullptr ? IUFindNumber(device.property, sensorIter->key) : nullptr;
+            sensor.role   = sensorRole({device.key, sensor.key});
+            device.sensors.push_back(sensor);
+        }
+        bindings.push_back(device);
+    }
+
+    ambientTemperatureSensor = findRawSensorProperty(currentSensors.temp_ambient);
+    objectTemperatureSensor  = findRawSensorProperty(currentSensors.temp_object);
+
+    LOGF_DEBUG("Sensor bindings for %zu devices %s.", bindings.size(), bindingsValid ? "resolved" : "incomplete");
+}
+
+/**************************************************************************************
+** Update sensors through the bindings
+***************************************************************************************/
+bool WeatherRadio::applyBindings(JsonValue &value)
+{
+    size_t deviceIndex = 0;
+    for (JsonIterator deviceIter = begin(value); deviceIter != end(value); ++deviceIter, ++deviceIndex)
+    {
+        if (deviceIndex >= bindings.size() || bindings[deviceIndex].key != deviceIter->key)
+        {
+            bindingsValid = false;
+            return false;
+        }
+        const device_binding &device = bindings[deviceIndex];
+
+        size_t sensorIndex = 0;
+        for (JsonIterator sensorIter = begin(deviceIter->value); sensorIter != end(deviceIter->value); ++sensorIter)
+        {
+            if (strcmp(sensorIter->key, "init") == 0 || sensorIter->value.getTag() != JSON_NUMBER)
+                continue;
+
+            if (sensorIndex >= device.sensors.size() || device.sensors[sensorIndex].key != sensorIter->key)
+            {
+                bindingsValid = false;
+                return false;
+            }
+            const sensor_binding &sensor = device.sensors[sensorIndex++];
+            if (sensor.number != nullptr)
+            {
+                sensor.number->value = sensorIter->value.toNumber();
+                updateWeatherParameter(sensor.role, sensor.number->value);
+            }
+        }
+        if (sensorIndex != device.sensors.size())
+        {
+            bindingsValid = false;
+            return false;
+        }
+        // update device values
+        IDSetNumber(device.property, nullptr);
+    }
+    // a device missing from the document changes the layout as well
+    if (deviceIndex != bindings.size())
+    {
+        bindingsValid = false;
+        return false;
+    }
+    return true;
+}
+
 /**************************************************************************************
 ** Sensor selection changed
 ***************************************************************************************/
@@ -1157,6 +1254,9 @@ WeatherRadio::sensor_name WeatherRadio::updateSensorSelection(ISwitchVectorPrope
     else
         weatherParameter->s = IPS_IDLE;
 
+    // the sensor roles are part of the bindings
+    bindingsValid = false;
+
     IDSetSwitch(weatherParameter, nullptr);
     return sensor;
 }
@@ -1165,10 +1265,49 @@ WeatherRadio::sensor_name WeatherRadio::updateSensorSelection(ISwitchVectorPrope
 ** Update the value of the WEATHER_... from its sensor value
 ***************************************************************************************/
 void WeatherRadio::updateWeatherParameter(WeatherRadio::sensor_name sensor, double value)
+{
+    updateWeatherParameter(sensorRole(sensor), value);
+}
+
+WeatherRadio::SENSOR_ROLE WeatherRadio::sensorRole(WeatherRadio::sensor_name sensor)
 {
     if (currentSensors.temperature == sensor)
-        setParameterValue(WEATHER_TEMPERATURE, weatherCalculator->calibrate(weatherCalculator->temperatureCalibration, value));
+        return TEMPERATURE_ROLE;
     else if (currentSensors.pressure == sensor)
+        return PRESSURE_ROLE;
+    else if (currentSensors.humidity == sensor)
+        return HUMIDITY_ROLE;
+    else if (currentSensors.temp_ambient == sensor)
+        return TEMP_AMBIENT_ROLE;
+    else if (currentSensors.temp_object == sensor)
+        return TEMP_OBJECT_ROLE;
+    else if (currentSensors.luminosity == sensor)
+        return LUMINOSITY_ROLE;
+    else if (currentSensors.sqm == sensor)
+        return SQM_ROLE;
+    else if (currentSensors.wind_gust == sensor)
+        return WIND_GUST_ROLE;
+    else if (currentSensors.wind_speed == sensor)
+        return WIND_SPEED_ROLE;
+    else if (currentSensors.wind_direction == sensor)
+        return WIND_DIRECTION_ROLE;
+    else if (currentSensors.rain_drops == sensor)
+        return RAIN_DROPS_ROLE;
+    else if (currentSensors.rain_volume == sensor)
+        return RAIN_VOLUME_ROLE;
+    else if (currentSensors.wetness == sensor)
+        return WETNESS_ROLE;
+    return NO_ROLE;
+}
+
+void WeatherRadio::updateWeatherParameter(SENSOR_ROLE role, double value)
+{
+    switch (role)
+    {
+    case TEMPERATURE_ROLE:
+        setParameterValue(WEATHER_TEMPERATURE, weatherCalculator->calibrate(weatherCalculator->temperatureCalibration, value));
+        break;
+    case PRESSURE_ROLE:
     {
         double elevation = LocationN[LOCATION_ELEVATION].value;
 
@@ -1179,8 +1318,9 @@ void WeatherRadio::updateWeatherParameter(WeatherRadio::sensor_name sensor, doub
 
         double pressure_normalized = weatherCalculator->sealevelPressure(value, elevation, temp);
         setParameterValue(WEATHER_PRESSURE, pressure_normalized);
+        break;
     }
-    else if (currentSensors.humidity == sensor)
+    case HUMIDITY_ROLE:
     {
         double humidity = weatherCalculator->calibrate(weatherCalculator->humidityCalibration, value);
 
@@ -1191,48 +1331,54 @@ void WeatherRadio::updateWeatherParameter(WeatherRadio::sensor_name sensor, doub
             double dp =  weatherCalculator->dewPoint(humidity, temperatureParameter->value);
             setParameterValue(WEATHER_DEWPOINT, dp);
         }
-     }
-    else if (currentSensors.temp_ambient == sensor)
-    {
+        break;
+    }
+    case TEMP_AMBIENT_ROLE:
         // obtain the current object temperature
-        INumber *objProp = findRawSensorProperty(currentSensors.temp_object);
-        if (objProp != nullptr)
+        if (objectTemperatureSensor != nullptr)
         {
-            double objectTemperature = objProp->value;
+            double objectTemperature = objectTemperatureSensor->value;
             setParameterValue(WEATHER_CLOUD_COVER, weatherCalculator->cloudCoverage(value, objectTemperature));
             setParameterValue(WEATHER_SKY_TEMPERATURE, weatherCalculator->skyTemperatureCorr(value, objectTemperature));
         }
-    }
-    else if (currentSensors.temp_object == sensor)
-    {
+        break;
+    case TEMP_OBJECT_ROLE:
         // obtain the current ambient temperature
-        INumber *ambientProp = findRawSensorProperty(currentSensors.temp_ambient);
-        if (ambientProp != nullptr)
+        if (ambientTemperatureSensor != nullptr)
         {
-            double ambientTemperature = ambientProp->value;
+            double ambientTemperature = ambientTemperatureSensor->value;
             setParameterValue(WEATHER_CLOUD_COVER, weatherCalculator->cloudCoverage(ambientTemperature, value));
             setParameterValue(WEATHER_SKY_TEMPERATURE, weatherCalculator->skyTemperatureCorr(ambientTemperature, value));
         }
-    }
-    else if (currentSensors.luminosity == sensor)
-    {
+        break;
+    case LUMINOSITY_ROLE:
         setParameterValue(WEATHER_SQM, weatherCalculator->calibrate(weatherCalculator->sqmCalibration,
                                                                     weatherCalculator->sqmValue(value)));
-    }
-    else if (currentSensors.sqm == sensor)
+        break;
+    case SQM_ROLE:
         setParameterValue(WEATHER_SQM, weatherCalculator->calibrate(weatherCalculator->sqmCalibration, value));
-    else if (currentSensors.wind_gust == sensor)
+        break;
+    case WIND_GUST_ROLE:
         setParameterValue(WEATHER_WIND_GUST, value);
-    else if (currentSensors.wind_speed == sensor)
+        break;
+    case WIND_SPEED_ROLE:
         setParameterValue(WEATHER_WIND_SPEED, value);
-    else if (currentSensors.wind_direction == sensor)
+        break;
+    case WIND_DIRECTION_ROLE:
         setParameterValue(WEATHER_WIND_DIRECTION, weatherCalculator->calibratedWindDirection(value));
-    else if (currentSensors.rain_drops == sensor)
+        break;
+    case RAIN_DROPS_ROLE:
         setParameterValue(WEATHER_RAIN_DROPS, value);
-    else if (currentSensors.rain_volume == sensor)
+        break;
+    case RAIN_VOLUME_ROLE:
         setParameterValue(WEATHER_RAIN_VOLUME, value);
-    else if (currentSensors.wetness == sensor)
+        break;
+    case WETNESS_ROLE:
         setParameterValue(WEATHER_WETNESS, weatherCalculator->calibrate(weatherCalculator->wetnessCalibration, value));
+        break;
+    case NO_ROLE:
+        break;
+    }
 }
 
 /**************************************************************************************
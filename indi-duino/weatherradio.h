@@ -28,6 +28,7 @@
 
 #include "indiweather.h"
 #include "weathercalculator.h"
+#include "gason/gason.h"
 
 extern const char *CALIBRATION_TAB;
 extern const char *TOKEN;
@@ -254,6 +255,60 @@ protected:
      */
     void updateWeatherParameter(sensor_name sensor, double value);
 
+    /**
+     * Weather parameter a sensor is selected for
+     */
+    enum SENSOR_ROLE {NO_ROLE, TEMPERATURE_ROLE, PRESSURE_ROLE, HUMIDITY_ROLE, TEMP_AMBIENT_ROLE, TEMP_OBJECT_ROLE,
+                      LUMINOSITY_ROLE, SQM_ROLE, WIND_GUST_ROLE, WIND_SPEED_ROLE, WIND_DIRECTION_ROLE,
+                      RAIN_DROPS_ROLE, RAIN_VOLUME_ROLE, WETNESS_ROLE};
+
+    /**
+     * @brief Determine the weather parameter a sensor is currently selected for.
+     */
+    SENSOR_ROLE sensorRole(sensor_name sensor);
+
+    /**
+     * @brief Update the weather parameter of the given role.
+     */
+    void updateWeatherParameter(SENSOR_ROLE role, double value);
+
+    /**
+     * Sensor to property bindings, resolved once for the device layout
+     * reported by the station so that updates need no name lookups.
+     * The weather data is expected to list devices and sensors in the same
+     * order every time, any deviation invalidates the bindings.
+     */
+    struct sensor_binding
+    {
+        std::string key;  // JSON key of the sensor
+        INumber *number;  // raw sensor property, nullptr if unknown
+        SENSOR_ROLE role;
+    };
+
+    struct device_binding
+    {
+        std::string key;  // JSON key of the device
+        INumberVectorProperty *property;
+        std::vector<sensor_binding> sensors;
+    };
+
+    std::vector<device_binding> bindings;
+    bool bindingsValid = false;
+    // raw sensors selected for the cloud coverage calculation
+    INumber *ambientTemperatureSensor = nullptr;
+    INumber *objectTemperatureSensor = nullptr;
+
+    /**
+     * @brief Resolve the bindings for the device layout of the given weather document.
+     */
+    void updateBindings(JsonValue &value);
+
+    /**
+     * @brief Update all sensors through the bindings.
+     * @return false if the document does not match the bindings
+     */
+    bool applyBindings(JsonValue &value);
+
     /**
      * @brief Read the firmware configuration
      * @param config configuration to be updated
@@ -335,6 +335,8 @@ void EQMod::ISGetProperties(const char *dev)
         defineProperty(TrackDefaultSP);
         defineProperty(ST4GuideRateNSSP);
         defineProperty(ST4GuideRateWESP);
+        if (mount->isUDP())
+            defineProperty(UDPStatisticsNP);
 
 #if defined WITH_ALIGN && defined WITH_ALIGN_GEEHALEL
         defineProperty(&AlignMethodSP);
@@ -432,6 +434,7 @@ bool EQMod::loadProperties()
     DEPPECTrainingSP    = getSwitch("DE_PPEC_TRAINING");
     DEPPECSP            = getSwitch("DE_PPEC");
     LEDBrightnessNP     = getNumber("LED_BRIGHTNESS");
+    UDPStatisticsNP     = getNumber("UDP_STATISTICS");
     SNAPPORT1SP         = getSwitch("SNAPPORT1");
     SNAPPORT2SP         = getSwitch("SNAPPORT2");
 #ifdef WITH_ALIGN_GEEHALEL
@@ -494,6 +497,8 @@ bool EQMod::updateProperties()
         defineProperty(TrackDefaultSP);
         defineProperty(ST4GuideRateNSSP);
         defineProperty(ST4GuideRateWESP);
+        if (mount->isUDP())
+            defineProperty(UDPStatisticsNP);
 
 #if defined WITH_ALIGN && defined WITH_ALIGN_GEEHALEL
         defineProperty(&AlignMethodSP);
@@ -652,6 +657,7 @@ bool EQMod::updateProperties()
         deleteProperty(ST4GuideRateNSSP->name);
         deleteProperty(ST4GuideRateWESP->name);
         deleteProperty(LEDBrightnessNP->name);
+        deleteProperty(UDPStatisticsNP->name);
 
         if (mount->HasHomeIndexers())
             deleteProperty(AutoHomeSP->name);
@@ -713,13 +719,15 @@ bool EQMod::Handshake()
 {
     try
     {
-        if (!getActiveConnection()->name().compare("CONNECTION_TCP")
-                && tcpConnection->connectionType() == Connection::TCP::TYPE_UDP)
+        bool udp = !getActiveConnection()->name().compare("CONNECTION_TCP")
+                   && tcpConnection->connectionType() == Connection::TCP::TYPE_UDP;
+        if (udp)
         {
             tty_set_generic_udp_format(1);
         }
 
         mount->setPortFD(PortFD);
+        mount->setUDP(udp);
         mount->Handshake();
         // Mount initialisation is in updateProperties as it sets directly Indi properties which should be defined
     }
@@ -964,6 +972,12 @@ bool EQMod::ReadScopeStatus()
         IUUpdateNumber(PeriodsNP, periods, (char **)periodsnames, 2);
         IDSetNumber(PeriodsNP, nullptr);
 
+        if (mount->isUDP())
+        {
+            mount->GetUDPStatistics(UDPStatisticsNP);
+            IDSetNumber(UDPStatisticsNP, nullptr);
+        }
+
         // Log all coords
         {
             char CurrentRAString[64] = {0}, CurrentDEString[64] = {0},
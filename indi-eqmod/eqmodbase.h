@@ -114,6 +114,7 @@ class EQMod : public INDI::Telescope, public INDI::GuiderInterface
         INumberVectorProperty *BacklashNP          = nullptr;
         ISwitchVectorProperty *UseBacklashSP       = nullptr;
         INumberVectorProperty *LEDBrightnessNP     = nullptr;
+        INumberVectorProperty *UDPStatisticsNP     = nullptr;
 #if defined WITH_ALIGN && defined WITH_ALIGN_GEEHALEL
         ISwitch AlignMethodS[2];
         ISwitchVectorProperty AlignMethodSP;
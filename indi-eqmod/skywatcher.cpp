@@ -22,6 +22,7 @@
 #include <indicom.h>
 
 #include <termios.h>
+#include <cerrno>
 #include <cmath>
 #include <cstring>
 
@@ -51,6 +52,33 @@ bool Skywatcher::isDebug()
 void Skywatcher::setPortFD(int value)
 {
     PortFD = value;
+    udpTransport.setFD(value);
+}
+
+void Skywatcher::setUDP(bool enable)
+{
+    udp = enable;
+    udpTransport.setFD(PortFD);
+    udpTransport.resetStatistics();
+}
+
+bool Skywatcher::isUDP()
+{
+    return udp;
+}
+
+void Skywatcher::GetUDPStatistics(INumberVectorProperty *statisticsNP)
+{
+    const UDPTransport::Statistics &stats = udpTransport.getStatistics();
+    double statisticsvalues[5];
+    const char *statisticsnames[] = { "UDP_RTT", "UDP_TIMEOUT", "UDP_LOSS", "UDP_RETRANSMITS", "UDP_FAILURES" };
+
+    statisticsvalues[0] = stats.smoothedRTT;
+    statisticsvalues[1] = stats.timeout;
+    statisticsvalues[2] = stats.lossRate() * 100.0;
+    statisticsvalues[3] = stats.retransmits;
+    statisticsvalues[4] = stats.failures;
+    IUUpdateNumber(statisticsNP, statisticsvalues, (char **)statisticsnames, 5);
 }
 
 void Skywatcher::setSimulation(bool enable)
@@ -1696,6 +1724,16 @@ double Skywatcher::get_max_rate()
 
 bool Skywatcher::dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, char *command_arg)
 {
+    if (udp && !isSimulation())
+    {
+        if (command_arg == nullptr)
+            snprintf(command, SKYWATCHER_MAX_CMD, "%c%c%c%c", SkywatcherLeadingChar, cmd, AxisCmd[axis], SkywatcherTrailingChar);
+        else
+            snprintf(command, SKYWATCHER_MAX_CMD, "%c%c%c%s%c", SkywatcherLeadingChar, cmd, AxisCmd[axis], command_arg,
+                     SkywatcherTrailingChar);
+        return dispatch_udp_command(cmd);
+    }
+
     for (uint8_t i = 0; i < EQMOD_MAX_RETRY; i++)
     {
         // Clear string
@@ -1760,6 +1798,65 @@ bool Skywatcher::dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, ch
     return true;
 }
 
+bool Skywatcher::dispatch_udp_command(SkywatcherCommand cmd)
+{
+    // Retransmissions and timeouts are handled by the transport. Replies do not echo
+    // the command, the transport waits out the late replies to earlier requests and
+    // the expected shape of the reply discards those to other commands.
+    int nbytes_written = strlen(command);
+    int nbytes_read    = udpTransport.transact(command, nbytes_written, response, SKYWATCHER_MAX_CMD - 1,
+                         GetReplyMatcher(cmd));
+    int err_code = errno;
+
+    command[nbytes_written - 1] = '\0'; //hmmm, remove \r, the  SkywatcherTrailingChar
+    DEBUGF(telescope->DBG_COMM, "dispatch_command: \"%s\", %d bytes written", command, nbytes_written);
+
+    if (nbytes_read < 0)
+    {
+        const UDPTransport::Statistics &stats = udpTransport.getStatistics();
+        throw EQModError(EQModError::ErrDisconnect, "udp request %s failed, check connection: %s (timeout %.0f ms)", command,
+                         strerror(err_code), stats.timeout);
+    }
+
+    debugnextread = true;
+    return check_response(nbytes_read);
+}
+
+UDPTransport::Matcher Skywatcher::GetReplyMatcher(char cmd)
+{
+    const size_t datalength = reply_length(static_cast<SkywatcherCommand>(cmd));
+    return [datalength](const char *reply, size_t length)
+    {
+        if (length < 2 || reply[length - 1] != SkywatcherTrailingChar)
+            return false;
+        if (reply[0] == '!')
+            return true;
+        return reply[0] == '=' && (datalength == 0 ? length == 2 : length >= datalength + 2);
+    };
+}
+
+size_t Skywatcher::reply_length(SkywatcherCommand cmd)
+{
+    switch (cmd)
+    {
+        case InquireMotorBoardVersion:
+        case InquireGridPerRevolution:
+        case InquireTimerInterruptFreq:
+        case InquirePECPeriod:
+        case GetAxisPosition:
+        case GetStepPeriod:
+        case GetHomePosition: // same as InquireAuxEncoder
+        case GetFeatureCmd:
+            return 6;
+        case GetAxisStatus:
+            return 3;
+        case InquireHighSpeedRatio:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
 bool Skywatcher::read_eqmod()
 {
     int err_code = 0, nbytes_read = 0;
@@ -1783,6 +1880,12 @@ bool Skywatcher::read_eqmod()
     {
         telescope->simulator->send_reply(response, &nbytes_read);
     }
+
+    return check_response(nbytes_read);
+}
+
+bool Skywatcher::check_response(int nbytes_read)
+{
     // Remove CR
     response[nbytes_read - 1] = '\0';
 
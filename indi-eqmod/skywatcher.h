@@ -18,6 +18,7 @@
 #pragma once
 
 #include "eqmoderror.h"
+#include "udptransport.h"
 
 #include <inditelescope.h>
 
@@ -133,6 +134,11 @@ class Skywatcher
         bool GetSnapPort2Status();
 
         void setPortFD(int value);
+        void setUDP(bool enable);
+        bool isUDP();
+        void GetUDPStatistics(INumberVectorProperty *statisticsNP);
+        // Whether a datagram has the shape of a reply to command cmd
+        static UDPTransport::Matcher GetReplyMatcher(char cmd);
 
     private:
         // Official Skywatcher Protocol
@@ -277,6 +283,9 @@ class Skywatcher
 
         bool read_eqmod();
         bool dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, char *arg);
+        bool dispatch_udp_command(SkywatcherCommand cmd);
+        bool check_response(int nbytes_read);
+        static size_t reply_length(SkywatcherCommand cmd);
 
         uint32_t Revu24str2long(char *);
         uint32_t Highstr2long(char *);
@@ -321,6 +330,8 @@ class Skywatcher
         SkyWatcherFeatures AxisFeatures[NUMBER_OF_SKYWATCHERAXIS];
 
         int PortFD = -1;
+        bool udp = false;
+        UDPTransport udpTransport;
         char command[SKYWATCHER_MAX_CMD];
         char response[SKYWATCHER_MAX_CMD];
 
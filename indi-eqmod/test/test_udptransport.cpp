@@ -0,0 +1,252 @@
+
+#include <gtest/gtest.h>
+
+#include "skywatcher.h"
+#include "udptransport.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+// Local stand-in for a WiFi mount: answers every request datagram ":<cmd><axis>\r"
+// with "=<data>\r" like the mount, without echoing the command. The data repeats
+// the axis digit, so that the tests can check which request was answered.
+// Datagrams are dropped and delayed as configured.
+class LossyMount
+{
+    public:
+        LossyMount()
+        {
+            server = socket(AF_INET, SOCK_DGRAM, 0);
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port        = 0;
+            bind(server, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+            socklen_t len = sizeof(addr);
+            getsockname(server, reinterpret_cast<struct sockaddr *>(&addr), &len);
+
+            client = socket(AF_INET, SOCK_DGRAM, 0);
+            connect(client, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+
+            worker = std::thread(&LossyMount::run, this);
+        }
+
+        ~LossyMount()
+        {
+            running = false;
+            worker.join();
+            close(client);
+            close(server);
+        }
+
+        int fd() const
+        {
+            return client;
+        }
+
+        // Drop every n-th request, zero keeps all of them
+        std::atomic<int> dropEvery {0};
+        // Drop this many requests from now on
+        std::atomic<int> dropNext {0};
+        std::atomic<int> delayMs {0};
+        // Send each reply twice
+        std::atomic<bool> duplicate {false};
+        std::atomic<int> received {0};
+        std::atomic<int> replies {0};
+
+        static size_t dataLength(char cmd)
+        {
+            switch (cmd)
+            {
+                case 'e':
+                case 'j':
+                    return 6;
+                case 'f':
+                    return 3;
+                default:
+                    return 0;
+            }
+        }
+
+    private:
+        void run()
+        {
+            char buffer[64];
+            while (running)
+            {
+                struct pollfd pfd = { server, POLLIN, 0 };
+                if (poll(&pfd, 1, 10) <= 0)
+                    continue;
+
+                struct sockaddr_in from;
+                socklen_t len = sizeof(from);
+                ssize_t n = recvfrom(server, buffer, sizeof(buffer), 0, reinterpret_cast<struct sockaddr *>(&from), &len);
+                if (n <= 0)
+                    continue;
+                int count = ++received;
+                if (dropNext > 0)
+                {
+                    dropNext--;
+                    continue;
+                }
+                if (dropEvery > 0 && count % dropEvery == 0)
+                    continue;
+                if (delayMs > 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+
+                std::string reply = n < 4 ? "!0\r" : "=" + std::string(dataLength(buffer[1]), buffer[2]) + "\r";
+                for (int i = 0; i < (duplicate ? 2 : 1); i++)
+                    sendto(server, reply.data(), reply.size(), 0, reinterpret_cast<struct sockaddr *>(&from), len);
+                replies += duplicate ? 2 : 1;
+            }
+        }
+
+        int server {-1};
+        int client {-1};
+        std::atomic<bool> running {true};
+        std::thread worker;
+};
+
+// Send cmd with the reply matcher of the driver
+static std::string request(UDPTransport &transport, const std::string &cmd)
+{
+    char reply[64];
+    std::string datagram = ":" + cmd + "\r";
+    int n = transport.transact(datagram.data(), datagram.size(), reply, sizeof(reply),
+                               Skywatcher::GetReplyMatcher(cmd[0]));
+    return n < 0 ? std::string() : std::string(reply, n);
+}
+
+// Reply of the mount to cmd
+static std::string answer(const std::string &cmd)
+{
+    return "=" + std::string(LossyMount::dataLength(cmd[0]), cmd[1]) + "\r";
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+TEST(UDPTransportTest, HealthyLinkLearnsShortTimeout)
+{
+    LossyMount mount;
+    UDPTransport transport;
+    transport.setFD(mount.fd());
+
+    for (int i = 0; i < 50; i++)
+        ASSERT_EQ(request(transport, "j1"), answer("j1"));
+
+    const UDPTransport::Statistics &stats = transport.getStatistics();
+    EXPECT_EQ(stats.requests, 50u);
+    EXPECT_EQ(stats.retransmits, 0u);
+    EXPECT_EQ(stats.failures, 0u);
+    EXPECT_DOUBLE_EQ(stats.lossRate(), 0.0);
+    // Loopback round trips are well below the minimum timeout
+    EXPECT_LT(stats.timeout, 100.0);
+}
+
+TEST(UDPTransportTest, LostDatagramCostsOneTimeout)
+{
+    LossyMount mount;
+    UDPTransport transport;
+    transport.setFD(mount.fd());
+
+    for (int i = 0; i < 20; i++)
+        ASSERT_EQ(request(transport, "j1"), answer("j1"));
+    double timeout = transport.getStatistics().timeout;
+
+    mount.dropNext = 1;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(request(transport, "f2"), answer("f2"));
+    double took = elapsedMs(start);
+
+    EXPECT_GE(took, timeout - 1);
+    EXPECT_LT(took, timeout + 200);
+    EXPECT_EQ(transport.getStatistics().retransmits, 1u);
+    EXPECT_GT(transport.getStatistics().lossRate(), 0.0);
+}
+
+TEST(UDPTransportTest, PeriodicLossStillAnswersEveryRequest)
+{
+    LossyMount mount;
+    mount.dropEvery = 4;
+    UDPTransport transport;
+    transport.setFD(mount.fd());
+
+    for (int i = 0; i < 40; i++)
+        ASSERT_EQ(request(transport, i % 2 ? "j1" : "j2"), answer(i % 2 ? "j1" : "j2"));
+
+    const UDPTransport::Statistics &stats = transport.getStatistics();
+    EXPECT_EQ(stats.failures, 0u);
+    EXPECT_GT(stats.retransmits, 0u);
+    EXPECT_NEAR(stats.lossRate(), 0.25, 0.1);
+}
+
+TEST(UDPTransportTest, DelayedRepliesAreNotTakenForLaterRequests)
+{
+    LossyMount mount;
+    UDPTransport transport;
+    transport.setLimits(10, 40, 5);
+    transport.setFD(mount.fd());
+
+    // Replies arrive after the timeout, so every request is retransmitted
+    // and the late copies must not be returned for the next requests. Both
+    // axes have replies of the same shape.
+    mount.delayMs = 60;
+    for (int i = 0; i < 10; i++)
+    {
+        std::string cmd = i % 2 ? "j1" : "j2";
+        ASSERT_EQ(request(transport, cmd), answer(cmd));
+    }
+    EXPECT_GT(transport.getStatistics().stale, 0u);
+    EXPECT_EQ(transport.getStatistics().failures, 0u);
+}
+
+TEST(UDPTransportTest, DuplicateRepliesAreDiscarded)
+{
+    LossyMount mount;
+    mount.duplicate = true;
+    UDPTransport transport;
+    transport.setFD(mount.fd());
+
+    // A duplicate which arrives after the next request cannot be told from its
+    // reply, so let both copies arrive first, as duplicates on a network do.
+    for (int i = 0; i < 10; i++)
+    {
+        std::string cmd = i % 2 ? "j1" : "j2";
+        ASSERT_EQ(request(transport, cmd), answer(cmd));
+        while (mount.replies < 2 * (i + 1))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GT(transport.getStatistics().stale, 0u);
+}
+
+TEST(UDPTransportTest, DeadLinkFailsAfterBoundedTime)
+{
+    LossyMount mount;
+    mount.dropEvery = 1;
+    UDPTransport transport;
+    transport.setLimits(25, 200, 4);
+    transport.setFD(mount.fd());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(request(transport, "e1"), "");
+    double took = elapsedMs(start);
+
+    // 200 + 200 + 200 + 200 ms with the initial timeout clamped to the maximum
+    EXPECT_LT(took, 1000.0);
+    EXPECT_EQ(mount.received, 4);
+    EXPECT_EQ(transport.getStatistics().failures, 1u);
+    EXPECT_DOUBLE_EQ(transport.getStatistics().lossRate(), 1.0);
+}
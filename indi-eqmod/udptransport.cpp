@@ -0,0 +1,184 @@
+/* This file is part of the Skywatcher Protocol INDI driver.
+
+    The Skywatcher Protocol INDI driver is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Skywatcher Protocol INDI driver is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Skywatcher Protocol INDI driver.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "udptransport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#define UDP_INITIAL_TIMEOUT 250.0 // ms, until the first round trip is measured
+#define UDP_MAX_DATAGRAM    512
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedMs(Clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+UDPTransport::UDPTransport()
+{
+    resetStatistics();
+}
+
+void UDPTransport::setFD(int value)
+{
+    fd     = value;
+    srtt   = 0;
+    rttVar = -1;
+    rto    = std::min(std::max(UDP_INITIAL_TIMEOUT, minTimeout), maxTimeout);
+    stats.timeout = rto;
+}
+
+void UDPTransport::setLimits(double minValue, double maxValue, int attempts)
+{
+    minTimeout  = minValue;
+    maxTimeout  = std::max(minValue, maxValue);
+    maxAttempts = std::max(attempts, 1);
+    rto         = std::min(std::max(rto, minTimeout), maxTimeout);
+    stats.timeout = rto;
+}
+
+void UDPTransport::resetStatistics()
+{
+    stats = Statistics();
+    stats.smoothedRTT = srtt;
+    stats.timeout     = rto;
+}
+
+void UDPTransport::drain()
+{
+    char buffer[UDP_MAX_DATAGRAM];
+
+    // After retransmissions, the replies to the other copies of the previous
+    // request may still be on their way. A reply does not tell which request it
+    // answers, so wait for them as long as the answered copy took, plus one timeout.
+    while (true)
+    {
+        int wait = outstanding > 0 ? static_cast<int>(std::max(0.0, std::ceil(lateness + rto - elapsedMs(lastSent)))) : 0;
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, wait) <= 0)
+            break;
+        if (recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT) < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ECONNREFUSED)
+                continue;
+            break;
+        }
+        stats.stale++;
+        if (outstanding > 0)
+            outstanding--;
+    }
+    outstanding = 0;
+}
+
+void UDPTransport::updateTimeout(double rtt)
+{
+    // RFC 6298
+    if (rttVar < 0)
+    {
+        srtt   = rtt;
+        rttVar = rtt / 2;
+    }
+    else
+    {
+        rttVar = 0.75 * rttVar + 0.25 * std::fabs(srtt - rtt);
+        srtt   = 0.875 * srtt + 0.125 * rtt;
+    }
+    rto = std::min(std::max(srtt + 4 * rttVar, minTimeout), maxTimeout);
+
+    stats.lastRTT     = rtt;
+    stats.smoothedRTT = srtt;
+    stats.timeout     = rto;
+}
+
+int UDPTransport::transact(const char *request, size_t requestLength, char *reply, size_t replySize,
+                           const Matcher &match)
+{
+    char buffer[UDP_MAX_DATAGRAM];
+    double timeout = rto;
+
+    // Whatever is queued now answers an earlier request
+    drain();
+    stats.requests++;
+
+    Clock::time_point first = Clock::now();
+
+    for (int attempt = 0; attempt < maxAttempts; attempt++)
+    {
+        if (send(fd, request, requestLength, 0) < 0)
+            return -1;
+        lastSent = Clock::now();
+        stats.transmissions++;
+        if (attempt > 0)
+            stats.retransmits++;
+
+        Clock::time_point sent = lastSent;
+        double left;
+        while ((left = timeout - elapsedMs(sent)) > 0)
+        {
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            int rc = poll(&pfd, 1, static_cast<int>(std::ceil(left)));
+            if (rc < 0 && errno != EINTR)
+                return -1;
+            if (rc <= 0)
+                continue;
+
+            ssize_t n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (n < 0)
+            {
+                // ECONNREFUSED reports an ICMP error for an earlier datagram, keep waiting
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ECONNREFUSED)
+                    continue;
+                return -1;
+            }
+            if (match && !match(buffer, static_cast<size_t>(n)))
+            {
+                stats.stale++;
+                continue;
+            }
+
+            // Karn's rule: a reply to a retransmitted request gives no usable round trip
+            if (attempt == 0)
+                updateTimeout(elapsedMs(sent));
+            else
+                stats.lastRTT = elapsedMs(sent);
+            stats.replies++;
+            outstanding = attempt;
+            lateness    = elapsedMs(first);
+
+            size_t length = std::min(static_cast<size_t>(n), replySize);
+            std::copy(buffer, buffer + length, reply);
+            return static_cast<int>(length);
+        }
+
+        timeout = std::min(timeout * 2, maxTimeout);
+    }
+
+    // Keep the backed off timeout for the next request, the link is likely degraded
+    rto = timeout;
+    stats.timeout = rto;
+    stats.failures++;
+    outstanding = maxAttempts;
+    lateness    = maxTimeout;
+    errno = ETIMEDOUT;
+    return -1;
+}
@@ -0,0 +1,106 @@
+/* This file is part of the Skywatcher Protocol INDI driver.
+
+    The Skywatcher Protocol INDI driver is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Skywatcher Protocol INDI driver is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Skywatcher Protocol INDI driver.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+/**
+ * Request/reply exchange over a connected UDP socket.
+ *
+ * Each request is one datagram and is answered by one datagram. Lost datagrams
+ * are retransmitted after a timeout derived from the measured round trip time
+ * (Jacobson/Karels, with Karn's rule and exponential backoff), so that a single
+ * loss costs tens of milliseconds on a healthy link instead of a fixed timeout.
+ * Datagrams that do not match the pending request are discarded. As replies
+ * need not tell which request they answer, the replies still due to the
+ * copies of a retransmitted request are awaited before the next request is
+ * sent, for as long as the answered copy took to be answered.
+ */
+class UDPTransport
+{
+    public:
+        typedef std::function<bool(const char *reply, size_t length)> Matcher;
+
+        struct Statistics
+        {
+            uint32_t requests {0};      // requests issued
+            uint32_t transmissions {0}; // datagrams sent, including retransmissions
+            uint32_t replies {0};       // matching replies received
+            uint32_t retransmits {0};
+            uint32_t failures {0};      // requests left without reply after all attempts
+            uint32_t stale {0};         // datagrams discarded as not matching the request
+            double lastRTT {0};         // ms
+            double smoothedRTT {0};     // ms
+            double timeout {0};         // current retransmission timeout, ms
+
+            /** Fraction of transmissions which were not answered */
+            double lossRate() const
+            {
+                return transmissions ? 1.0 - static_cast<double>(replies) / transmissions : 0.0;
+            }
+        };
+
+        UDPTransport();
+
+        void setFD(int fd);
+        int getFD() const
+        {
+            return fd;
+        }
+
+        /** Limits of the retransmission timeout in ms, and attempts per request */
+        void setLimits(double minTimeout, double maxTimeout, int maxAttempts);
+
+        /**
+         * @brief transact Send request and wait for its reply.
+         * @param match decides whether a received datagram answers the request, all datagrams match if empty
+         * @return length of the reply stored in reply, -1 if no matching reply arrived or the socket failed (errno is set)
+         */
+        int transact(const char *request, size_t requestLength, char *reply, size_t replySize,
+                     const Matcher &match = Matcher());
+
+        const Statistics &getStatistics() const
+        {
+            return stats;
+        }
+        void resetStatistics();
+
+    private:
+        void drain();
+        void updateTimeout(double rtt);
+
+        int fd {-1};
+        double minTimeout {25};
+        double maxTimeout {1000};
+        int maxAttempts {5};
+
+        // Round trip estimators in ms, rttVar is negative until the first sample
+        double srtt {0};
+        double rttVar {-1};
+        double rto {250};
+
+        // Copies of the previous request whose replies may still arrive, until
+        // lateness ms after the last copy was sent
+        int outstanding {0};
+        double lateness {0};
+        std::chrono::steady_clock::time_point lastSent;
+
+        Statistics stats;
+};
@@ -19,6 +19,7 @@
  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <algorithm>
 #include <memory>
 #include <time.h>
 #include <math.h>
@@ -38,6 +39,9 @@
 #define MAX_PIXELS     4096 /* Max number of pixels in one dimension */
 #define TEMP_THRESHOLD .25  /* Differential temperature threshold (C)*/
 #define MAX_DEVICES    20   /* Max device cameraCount */
+#define READY_POLL_MIN_MS  10     /* First readiness poll interval after the exposure ended */
+#define READY_POLL_MAX_MS  200    /* Readiness poll interval backs off up to this */
+#define READY_TIMEOUT_S    30     /* Give up if the camera is not ready this long after the exposure ended */
 
 static int cameraCount;
 static FishCampCCD *cameras[MAX_DEVICES];
@@ -206,6 +210,7 @@ FishCampCCD::FishCampCCD(int CamNum)
 
 FishCampCCD::~FishCampCCD()
 {
+    joinDownloadThread();
     fcUsb_CloseCamera(cameraNum);
 }
 
@@ -374,6 +379,8 @@ bool FishCampCCD::Disconnect()
 {
     LOG_INFO("Fishcamp CCD is offline.");
 
+    joinDownloadThread();
+
     if (sim)
         return true;
 
@@ -384,6 +391,9 @@ bool FishCampCCD::Disconnect()
 
 bool FishCampCCD::StartExposure(float duration)
 {
+    // The previous download has already delivered its frame, wait for the thread to exit
+    joinDownloadThread();
+
     PrimaryCCD.setExposureDuration(duration);
     ExposureRequest = duration;
 
@@ -418,6 +428,7 @@ bool FishCampCCD::AbortExposure()
     LOGF_DEBUG("fcUsb_cmd_abortExposure returns %d", rc);
 
     InExposure = false;
+    readyPollInterval = 0;
     return true;
 }
 
@@ -501,32 +512,77 @@ float FishCampCCD::CalcTimeLeft()
     return timeleft;
 }
 
-/* Downloads the image from the CCD.*/
+static double processCPUTimeMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/* Downloads the image from the CCD. Runs in the download thread.*/
 int FishCampCCD::grabImage()
 {
+    // ExposureComplete may start the next exposure, whose readiness polling resets these
+    auto frameReadyTime = readyTime;
+    auto frameWaitStart = readyWaitStart;
+    int framePolls      = readyPolls;
+    double frameWaitCPU = readyWaitCPU;
+
     std::unique_lock<std::mutex> guard(ccdBufferLock);
     uint8_t *image = PrimaryCCD.getFrameBuffer();
     UInt16 *frameBuffer = (UInt16 *)image;
     int numBytes = fcUsb_cmd_getRawFrame(cameraNum, PrimaryCCD.getSubW(), PrimaryCCD.getSubH(), frameBuffer);
+    downloadActive = false;
     guard.unlock();
+
     if(numBytes != 0)
-    {
         LOG_INFO("Download complete.");
-        ExposureComplete(&PrimaryCCD);
-        return 0;
-    }
     else
-    {
         LOG_INFO("Download error. Please check the log for details.");
-        ExposureComplete(&PrimaryCCD);  //This should be an error. It is not complete, it messed up!
-        return -1;
+
+    ExposureComplete(&PrimaryCCD);  //On error this is not complete, it messed up!
+
+    double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameReadyTime).count();
+    double wait    = std::chrono::duration<double, std::milli>(frameReadyTime - frameWaitStart).count();
+    LOGF_DEBUG("Camera ready after %.0f ms (%d polls), frame delivered %.0f ms later, %.0f ms CPU since exposure end.",
+               wait, framePolls, latency, processCPUTimeMs() - frameWaitCPU);
+
+    return (numBytes != 0) ? 0 : -1;
+}
+
+void FishCampCCD::joinDownloadThread()
+{
+    // ExposureComplete may start the next exposure from within the download thread itself
+    if (downloadThread.joinable() && downloadThread.get_id() != std::this_thread::get_id())
+        downloadThread.join();
+}
+
+/* Polls the camera state once, returns true when the frame can be downloaded.*/
+bool FishCampCCD::pollReadyState()
+{
+    if (readyPollInterval == 0)
+    {
+        readyPollInterval = READY_POLL_MIN_MS;
+        readyPolls        = 0;
+        readyWaitStart    = std::chrono::steady_clock::now();
+        readyWaitCPU      = processCPUTimeMs();
     }
 
+    readyPolls++;
+    if (sim || fcUsb_cmd_getState(cameraNum) == 0)
+    {
+        readyPollInterval = 0;
+        readyTime         = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    readyPollInterval = std::min(readyPollInterval * 2, READY_POLL_MAX_MS);
+    return false;
 }
 
 void FishCampCCD::TimerHit()
 {
-    int timerHitID = -1, state = -1, rc = -1;
+    int timerHitID = -1, rc = -1;
     float timeleft;
     double ccdTemp;
 
@@ -552,29 +608,30 @@ void FishCampCCD::TimerHit()
                     //  use an even tighter timer
                     timerHitID = SetTimer(50);
                 }
-                else
+                else if (pollReadyState())
                 {
-                    //  it's real close now, so spin on it
-                    //  We have to wait till the camera is ready to download
-                    bool ready = false;
-                    int slv;
-                    slv = fabs(100000 * timeleft); //0.05s (50000 us) is checked every 5000 us or so
-                    while (!sim && !ready)
-                    {
-                        state = fcUsb_cmd_getState(cameraNum);
-                        if (state == 0)
-                            ready = true;
-                        else
-                            usleep(slv);
-                    }
-
                     /* We're done exposing */
                     LOG_DEBUG("Exposure done, downloading image...");
 
                     PrimaryCCD.setExposureLeft(0);
                     InExposure = false;
-                    /* grab and save image */
-                    grabImage();
+                    /* grab and save image without blocking the main loop */
+                    joinDownloadThread();
+                    downloadActive = true;
+                    downloadThread = std::thread(&FishCampCCD::grabImage, this);
+                }
+                else if (-timeleft > READY_TIMEOUT_S)
+                {
+                    LOGF_ERROR("Camera not ready %d seconds after the exposure ended, aborting.", READY_TIMEOUT_S);
+                    AbortExposure();
+                    PrimaryCCD.setExposureFailed();
+                }
+                else
+                {
+                    //  We have to wait till the camera is ready to download,
+                    //  check again shortly without blocking the main loop
+                    timerHitID = SetTimer(readyPollInterval);
+                    return;
                 }
             }
         }
@@ -585,6 +642,14 @@ void FishCampCCD::TimerHit()
         }
     }
 
+    // The SDK does not serialize commands with the frame transfer, poll again on the next timer hit
+    if (downloadActive)
+    {
+        if (timerHitID == -1)
+            SetTimer(getCurrentPollingPeriod());
+        return;
+    }
+
     switch (TemperatureNP.s)
     {
         case IPS_IDLE:
@@ -23,7 +23,10 @@
 #define FISHCAMP_CCD_H
 
 #include <indiccd.h>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include <fishcamp.h>
 
@@ -92,6 +95,21 @@ class FishCampCCD : public INDI::CCD
 
     float CalcTimeLeft();
     int grabImage();
+    bool pollReadyState();
+    void joinDownloadThread();
+
+    // Readiness polling at the end of the exposure, the interval backs off
+    // from READY_POLL_MIN_MS to READY_POLL_MAX_MS while the camera is busy
+    int readyPollInterval {0};
+    int readyPolls {0};
+    std::chrono::steady_clock::time_point readyWaitStart;
+    std::chrono::steady_clock::time_point readyTime;
+    double readyWaitCPU {0};
+
+    // Image download runs off the INDI main loop, the camera is not polled
+    // for telemetry while it transfers the frame
+    std::thread downloadThread;
+    std::atomic<bool> downloadActive {false};
     bool setupParams();
     bool setGain(double gain);
 
@@ -22,7 +22,9 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <indilogger.h>
+#include <chrono>
 #include <memory>
+#include <vector>
 
 #define min(a, b)               \
     ({                          \
@@ -36,6 +38,8 @@
 #define MIN_FRAME_SIZE (512)
 #define MAX_FRAME_SIZE (SUBFRAME_SIZE * 16)
 #define SPECTRUM_SIZE  (256)
+// Samples buffered by LimeSuite for each channel in correlator mode
+#define CORRELATOR_FIFO_SIZE (1024 * 1024)
 
 static int iNumofConnectedSpectrographs;
 static LIMESDR *receivers[MAX_DEVICES];
@@ -195,6 +199,9 @@ bool LIMESDR::Connect()
     }
     LMS_Init(lime_dev);
     LMS_EnableChannel(lime_dev, LMS_CH_RX, 0, true);
+    rxChannels = LMS_GetNumChannels(lime_dev, LMS_CH_RX);
+    if (rxChannels > 1)
+        LMS_EnableChannel(lime_dev, LMS_CH_RX, 1, true);
     LOG_INFO("LIME-SDR Spectrograph connected successfully!");
     // Let's set a timer that checks teleSpectrographs status every POLLMS milliseconds.
     // JM 2017-07-31 SetTimer already called in updateProperties(). Just call it once
@@ -208,6 +215,7 @@ bool LIMESDR::Connect()
 ***************************************************************************************/
 bool LIMESDR::Disconnect()
 {
+    stopCorrelator();
     InIntegration = false;
     LMS_Close(lime_dev);
     setBufferSize(1);
@@ -242,6 +250,15 @@ bool LIMESDR::initProperties()
     setMinMaxStep("SPECTROGRAPH_SETTINGS", "SPECTROGRAPH_BANDWIDTH", 400.0e+6, 3.8e+9, 1, false);
     setMinMaxStep("SPECTROGRAPH_SETTINGS", "SPECTROGRAPH_BITSPERSAMPLE", -32, -32, 0, false);
     setIntegrationFileExtension("fits");
+
+    // Dual channel capture, correlating both RX channels in the driver
+    IUFillSwitch(&CaptureModeS[CAPTURE_SINGLE], "CAPTURE_SINGLE", "Single channel", ISS_ON);
+    IUFillSwitch(&CaptureModeS[CAPTURE_CORRELATOR], "CAPTURE_CORRELATOR", "Dual channel correlator", ISS_OFF);
+    IUFillSwitchVector(&CaptureModeSP, CaptureModeS, 2, getDeviceName(), "LIME_CAPTURE_MODE", "Capture mode",
+                       MAIN_CONTROL_TAB, IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+    IUFillNumber(&FFTSizeN[0], "FFT_SIZE", "FFT size", "%.0f", 64, 65536, 64, 1024);
+    IUFillNumberVector(&FFTSizeNP, FFTSizeN, 1, getDeviceName(), "LIME_CORRELATOR", "Correlator", MAIN_CONTROL_TAB, IP_RW,
+                       60, IPS_IDLE);
     /*
     // PrimarySpectrograph Device Continuum Blob
     IUFillBLOB(&TFitsB[0], "TRMT", "Transmit1", "");
@@ -273,6 +290,11 @@ bool LIMESDR::updateProperties()
         // Inital values
         setupParams(1000000, 1420000000, 10000, 10);
         //defineProperty(&TFitsBP);
+        if (rxChannels > 1)
+        {
+            defineProperty(&CaptureModeSP);
+            defineProperty(&FFTSizeNP);
+        }
 
         // Start the timer
         SetTimer(getCurrentPollingPeriod());
@@ -280,6 +302,11 @@ bool LIMESDR::updateProperties()
     else
     {
         //deleteProperty(TFitsBP.name);
+        if (rxChannels > 1)
+        {
+            deleteProperty(CaptureModeSP.name);
+            deleteProperty(FFTSizeNP.name);
+        }
     }
 
     return true;
@@ -297,6 +324,9 @@ bool LIMESDR::StartIntegration(float duration)
     b_read  = 0;
     to_read = getSampleRate() * getIntegrationTime();
 
+    if (CaptureModeS[CAPTURE_CORRELATOR].s == ISS_ON)
+        return startCorrelator();
+
     setBufferSize(to_read * sizeof(float));
 
     if (to_read > 0)
@@ -325,11 +355,15 @@ void LIMESDR::setupParams(float sr, float freq, float bw, float gain)
 {
     setBPS(-32);
     int r = 0;
-    r |= LMS_SetAntenna(lime_dev, LMS_CH_RX, 0, 0);
-    r |= LMS_SetNormalizedGain(lime_dev, LMS_CH_RX, 0, gain);
-    r |= LMS_SetLOFrequency(lime_dev, LMS_CH_RX, 0, freq);
     r |= LMS_SetSampleRate(lime_dev, sr, 0);
-    r |= LMS_Calibrate(lime_dev, LMS_CH_RX, 0, bw, 0);
+    // Both RX channels are tuned alike, so that they can be correlated
+    for (int channel = 0; channel < (rxChannels > 1 ? 2 : 1); channel++)
+    {
+        r |= LMS_SetAntenna(lime_dev, LMS_CH_RX, channel, 0);
+        r |= LMS_SetNormalizedGain(lime_dev, LMS_CH_RX, channel, gain);
+        r |= LMS_SetLOFrequency(lime_dev, LMS_CH_RX, channel, freq);
+        r |= LMS_Calibrate(lime_dev, LMS_CH_RX, channel, bw, 0);
+    }
 
     if (r != 0)
     {
@@ -354,14 +388,55 @@ bool LIMESDR::ISNewNumber(const char *dev, const char *name, double values[], ch
         }
         IDSetNumber(&SpectrographSettingsNP, nullptr);
     }
+    if (dev && !strcmp(dev, getDeviceName()) && !strcmp(name, FFTSizeNP.name))
+    {
+        if (InIntegration)
+        {
+            FFTSizeNP.s = IPS_ALERT;
+            IDSetNumber(&FFTSizeNP, "Cannot change the FFT size while integrating.");
+            return true;
+        }
+        // Round down to a power of two
+        int size = 64;
+        while (size * 2 <= values[0] && size * 2 <= FFTSizeN[0].max)
+            size *= 2;
+        FFTSizeN[0].value = size;
+        FFTSizeNP.s = IPS_OK;
+        IDSetNumber(&FFTSizeNP, nullptr);
+        return true;
+    }
     return processNumber(dev, name, values, names, n) & !r;
 }
 
+bool LIMESDR::ISNewSwitch(const char *dev, const char *name, ISState *states, char *names[], int n)
+{
+    if (dev && !strcmp(dev, getDeviceName()) && !strcmp(name, CaptureModeSP.name))
+    {
+        if (InIntegration)
+        {
+            CaptureModeSP.s = IPS_ALERT;
+            IDSetSwitch(&CaptureModeSP, "Cannot change the capture mode while integrating.");
+            return true;
+        }
+        IUUpdateSwitch(&CaptureModeSP, states, names, n);
+        CaptureModeSP.s = IPS_OK;
+        IDSetSwitch(&CaptureModeSP, nullptr);
+        return true;
+    }
+    return INDI::Spectrograph::ISNewSwitch(dev, name, states, names, n);
+}
+
 /**************************************************************************************
 ** Client is asking us to abort a capture
 ***************************************************************************************/
 bool LIMESDR::AbortIntegration()
 {
+    if (correlatorThread.joinable())
+    {
+        stopCorrelator();
+        InIntegration = false;
+        return true;
+    }
     if (InIntegration)
     {
         lms_stream_status_t status;
@@ -404,7 +479,12 @@ void LIMESDR::TimerHit()
     if (isConnected() == false)
         return; //  No need to reset timer if we are not connected anymore
 
-    if (InIntegration)
+    if (InIntegration && correlatorRunning)
+    {
+        // The correlator thread completes the integration on its own
+        setIntegrationLeft(std::max(CalcTimeLeft(), 0.0f));
+    }
+    else if (InIntegration)
     {
         timeleft = CalcTimeLeft();
         if (timeleft < 0.1)
@@ -450,3 +530,136 @@ void LIMESDR::grabData()
         IntegrationComplete();
     }
 }
+
+/**************************************************************************************
+** Stream both RX channels in lockstep and correlate them
+***************************************************************************************/
+bool LIMESDR::startCorrelator()
+{
+    if (rxChannels < 2)
+    {
+        LOG_ERROR("Correlator mode needs a receiver with two RX channels.");
+        return false;
+    }
+    if (to_read <= 0)
+        return false;
+
+    stopCorrelator();
+
+    // Averaged auto spectra and cross spectrum, FFTSizeN[0] floats each
+    setBufferSize(4 * static_cast<int>(FFTSizeN[0].value) * sizeof(float));
+
+    lime_stream.channel             = 0;
+    lime_stream.isTx                = false;
+    lime_stream.fifoSize            = CORRELATOR_FIFO_SIZE;
+    lime_stream.dataFmt             = lms_stream_t::LMS_FMT_F32;
+    lime_stream.throughputVsLatency = 1.0;
+    lime_stream_b         = lime_stream;
+    lime_stream_b.channel = 1;
+    if (LMS_SetupStream(lime_dev, &lime_stream) != 0 || LMS_SetupStream(lime_dev, &lime_stream_b) != 0)
+    {
+        LOGF_ERROR("Failed to set up the RX streams: %s", LMS_GetLastErrorMessage());
+        LMS_DestroyStream(lime_dev, &lime_stream);
+        return false;
+    }
+    LMS_StartStream(&lime_stream);
+    LMS_StartStream(&lime_stream_b);
+
+    gettimeofday(&CapStart, nullptr);
+    InIntegration     = true;
+    correlatorRunning = true;
+    correlatorThread  = std::thread(&LIMESDR::correlate, this);
+    LOG_INFO("Correlation started...");
+    return true;
+}
+
+void LIMESDR::stopCorrelator()
+{
+    correlatorRunning = false;
+    if (!correlatorThread.joinable())
+        return;
+    // IntegrationComplete may start the next integration from within the correlator thread itself
+    if (correlatorThread.get_id() == std::this_thread::get_id())
+        correlatorThread.detach();
+    else
+        correlatorThread.join();
+}
+
+void LIMESDR::correlate()
+{
+    const size_t n = static_cast<size_t>(FFTSizeN[0].value);
+    LimeCorrelator::Accumulator accumulator(n);
+    std::vector<float> block0(2 * n), block1(2 * n);
+    lms_stream_meta_t meta0, meta1;
+    size_t dropped = 0;
+    bool failed = false;
+
+    memset(&meta0, 0, sizeof(meta0));
+    memset(&meta1, 0, sizeof(meta1));
+
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> busy(0);
+
+    while (correlatorRunning && accumulator.blocks() * n < static_cast<size_t>(to_read))
+    {
+        if (LMS_RecvStream(&lime_stream, block0.data(), n, &meta0, 1000) != static_cast<int>(n) ||
+                LMS_RecvStream(&lime_stream_b, block1.data(), n, &meta1, 1000) != static_cast<int>(n))
+        {
+            LOGF_ERROR("RX stream read failed: %s", LMS_GetLastErrorMessage());
+            failed = true;
+            break;
+        }
+
+        if (meta0.timestamp != meta1.timestamp)
+        {
+            // Drop samples from the channel that lags behind, both streams continue
+            // with the sample following the block just read from the leading one.
+            lms_stream_t *late = meta0.timestamp < meta1.timestamp ? &lime_stream : &lime_stream_b;
+            float *scratch = meta0.timestamp < meta1.timestamp ? block0.data() : block1.data();
+            uint64_t skew = meta0.timestamp < meta1.timestamp ? meta1.timestamp - meta0.timestamp :
+                            meta0.timestamp - meta1.timestamp;
+            dropped += skew + n;
+            while (skew > 0 && !failed)
+            {
+                int count = static_cast<int>(min(skew, static_cast<uint64_t>(n)));
+                failed = LMS_RecvStream(late, scratch, count, nullptr, 1000) != count;
+                skew -= count;
+            }
+            if (failed)
+            {
+                LOGF_ERROR("RX stream read failed: %s", LMS_GetLastErrorMessage());
+                break;
+            }
+            continue;
+        }
+
+        auto t = std::chrono::steady_clock::now();
+        accumulator.add(block0.data(), block1.data());
+        busy += std::chrono::steady_clock::now() - t;
+    }
+
+    LMS_StopStream(&lime_stream);
+    LMS_StopStream(&lime_stream_b);
+    LMS_DestroyStream(lime_dev, &lime_stream);
+    LMS_DestroyStream(lime_dev, &lime_stream_b);
+
+    if (!correlatorRunning)
+        return;
+    correlatorRunning = false;
+    InIntegration     = false;
+
+    if (failed)
+    {
+        setIntegrationFailed();
+        return;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double samples = static_cast<double>(accumulator.blocks() * n);
+    LOGF_DEBUG("Correlated %.0f samples per channel in %.2f s, FFT and accumulation at %.1f Msps, %zu samples dropped to align the channels.",
+               samples, elapsed.count(), busy.count() > 0 ? samples / busy.count() / 1.0e6 : 0.0, dropped);
+
+    accumulator.products(reinterpret_cast<float *>(getBuffer()));
+    LOG_INFO("Correlation complete.");
+    IntegrationComplete();
+}
@@ -21,6 +21,10 @@
 
 #include <lime/LimeSuite.h>
 #include "indispectrograph.h"
+#include "limesdr_correlator.h"
+
+#include <atomic>
+#include <thread>
 
 enum Settings
 {
@@ -35,6 +39,7 @@ class LIMESDR : public INDI::Spectrograph
     LIMESDR(uint32_t index);
 
     bool ISNewNumber(const char *dev, const char *name, double values[], char *names[], int n);
+    bool ISNewSwitch(const char *dev, const char *name, ISState *states, char *names[], int n);
 
   protected:
 	// General device functions
@@ -51,6 +56,7 @@ class LIMESDR : public INDI::Spectrograph
     void TimerHit();
 
     void grabData();
+    void correlate();
 
   private:
     lms_device_t *lime_dev = { nullptr };
@@ -58,6 +64,13 @@ class LIMESDR : public INDI::Spectrograph
 	float CalcTimeLeft();
     void setupParams(float sr, float freq, float bw, float gain);
     lms_stream_t lime_stream;
+    // Second RX channel, streamed in lockstep with lime_stream in correlator mode
+    lms_stream_t lime_stream_b;
+    int rxChannels = { 1 };
+    bool startCorrelator();
+    void stopCorrelator();
+    std::thread correlatorThread;
+    std::atomic_bool correlatorRunning { false };
 	// Are we exposing?
     bool InIntegration;
 	// Struct to keep timing
@@ -71,6 +84,17 @@ class LIMESDR : public INDI::Spectrograph
 
     uint32_t spectrographIndex = { 0 };
 
+    ISwitch CaptureModeS[2];
+    ISwitchVectorProperty CaptureModeSP;
+    enum
+    {
+        CAPTURE_SINGLE,
+        CAPTURE_CORRELATOR
+    };
+
+    INumber FFTSizeN[1];
+    INumberVectorProperty FFTSizeNP;
+
     IBLOB TFitsB[5];
     IBLOBVectorProperty TFitsBP;
 };
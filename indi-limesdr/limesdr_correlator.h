@@ -0,0 +1,153 @@
+/*
+    FFT correlator for two phase coherent receiver channels
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace LimeCorrelator
+{
+
+/** In place radix-2 complex FFT of a fixed power of two size */
+class FFT
+{
+  public:
+    explicit FFT(size_t n) : n(n), twiddles(n / 2), bitrev(n)
+    {
+        size_t bits = 0;
+        while ((size_t(1) << bits) < n)
+            bits++;
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; b++)
+                r |= ((i >> b) & 1) << (bits - 1 - b);
+            bitrev[i] = r;
+        }
+        for (size_t i = 0; i < n / 2; i++)
+            twiddles[i] = std::polar(1.0f, float(-2.0 * M_PI * i / n));
+    }
+
+    void forward(std::complex<float> *data) const
+    {
+        for (size_t i = 0; i < n; i++)
+            if (i < bitrev[i])
+                std::swap(data[i], data[bitrev[i]]);
+
+        for (size_t len = 2; len <= n; len <<= 1)
+        {
+            const size_t half = len / 2, step = n / len;
+            for (size_t i = 0; i < n; i += len)
+            {
+                for (size_t j = 0; j < half; j++)
+                {
+                    std::complex<float> t = twiddles[j * step] * data[i + j + half];
+                    data[i + j + half] = data[i + j] - t;
+                    data[i + j]       += t;
+                }
+            }
+        }
+    }
+
+  private:
+    size_t n;
+    std::vector<std::complex<float>> twiddles;
+    std::vector<size_t> bitrev;
+};
+
+/**
+ * Accumulates the auto spectra of both channels and their cross spectrum
+ * (visibility) over consecutive blocks of samples.
+ */
+class Accumulator
+{
+  public:
+    explicit Accumulator(size_t n) : n(n), fft(n), x0(n), x1(n), auto0(n), auto1(n), cross(n) { }
+
+    size_t size() const
+    {
+        return n;
+    }
+
+    size_t blocks() const
+    {
+        return nblocks;
+    }
+
+    void reset()
+    {
+        std::fill(auto0.begin(), auto0.end(), 0.0);
+        std::fill(auto1.begin(), auto1.end(), 0.0);
+        std::fill(cross.begin(), cross.end(), std::complex<double>(0, 0));
+        nblocks = 0;
+    }
+
+    /**
+     * @brief add Correlate one block of each channel.
+     * @param ch0 ch1 n complex samples as interleaved I/Q floats, time aligned
+     */
+    void add(const float *ch0, const float *ch1)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            x0[i] = std::complex<float>(ch0[2 * i], ch0[2 * i + 1]);
+            x1[i] = std::complex<float>(ch1[2 * i], ch1[2 * i + 1]);
+        }
+        fft.forward(x0.data());
+        fft.forward(x1.data());
+        for (size_t i = 0; i < n; i++)
+        {
+            auto0[i] += std::norm(x0[i]);
+            auto1[i] += std::norm(x1[i]);
+            cross[i] += std::complex<double>(x0[i] * std::conj(x1[i]));
+        }
+        nblocks++;
+    }
+
+    /**
+     * @brief products Average spectra, with the DC bin in the middle.
+     * @param out 4 * n floats: auto spectrum of channel 0 and 1, real and imaginary part of the cross spectrum
+     */
+    void products(float *out) const
+    {
+        const double scale = nblocks ? 1.0 / (double(nblocks) * n) : 0.0;
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t k = (i + n / 2) % n;
+            out[i]         = float(auto0[k] * scale);
+            out[n + i]     = float(auto1[k] * scale);
+            out[2 * n + i] = float(cross[k].real() * scale);
+            out[3 * n + i] = float(cross[k].imag() * scale);
+        }
+    }
+
+  private:
+    size_t n;
+    size_t nblocks { 0 };
+    FFT fft;
+    std::vector<std::complex<float>> x0, x1;
+    std::vector<double> auto0, auto1;
+    std::vector<std::complex<double>> cross;
+};
+
+}
@@ -25,6 +25,7 @@
 
 #include <connectionplugins/connectionserial.h>
 
+#include <algorithm>
 #include <memory>
 #include <math.h>
 #include <string.h>
@@ -80,10 +81,10 @@ MaxDomeII::MaxDomeII()
     nHomeAzimuth                = 0.0;
     nHomeTicks                  = 0;
     nCloseShutterBeforePark     = 0;
-    nTimeSinceShutterStart      = -1; // No movement has started
-    nTimeSinceAzimuthStart      = -1; // No movement has started
     nTargetAzimuth              = -1; //Target azimuth not established
-    nTimeSinceLastCommunication = 0;
+    nPollPeriod                 = 0;
+    nPollTimerID                = -1;
+    CommunicationTimer.start();
 
     SetDomeCapability(DOME_CAN_ABORT | DOME_CAN_ABS_MOVE | DOME_HAS_SHUTTER);
 
@@ -209,10 +210,87 @@ bool MaxDomeII::saveConfigItems(FILE *fp)
 bool MaxDomeII::Disconnect()
 {
     driver.Disconnect();
+    nPollTimerID = -1;
+    nPollPeriod  = 0;
 
     return INDI::Dome::Disconnect();
 }
 
+void MaxDomeIITimer::start()
+{
+    active = true;
+    moved  = false;
+    since  = std::chrono::steady_clock::now();
+}
+
+void MaxDomeIITimer::stop()
+{
+    active = false;
+}
+
+double MaxDomeIITimer::elapsed() const
+{
+    if (!active)
+        return 0;
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+uint32_t MaxDomeIIPollPeriod(bool moving, uint32_t previous, uint32_t pollingPeriod, uint32_t limit)
+{
+    uint32_t period;
+
+    if (moving)
+        period = std::min<uint32_t>(MD_POLL_MOVING_MS, pollingPeriod);
+    else
+        period = std::min(std::max(previous * 2, pollingPeriod), pollingPeriod * MD_POLL_IDLE_FACTOR);
+
+    if (limit > 0)
+        period = std::min(period, std::max<uint32_t>(limit, MD_POLL_MOVING_MS));
+
+    return period;
+}
+
+bool MaxDomeIIAzimuthStopped(MaxDomeIITimer &timer, AzStatus status)
+{
+    switch (status)
+    {
+        case AS_MOVING_WE:
+        case AS_MOVING_EW:
+            timer.markMoving();
+            return false;
+        case AS_IDLE:
+        case AS_IDLE2:
+            // Once the movement has been seen, idle means it has ended. Otherwise give the
+            // motor time to start before deciding the dome is not going to move.
+            return timer.running() && (timer.hasMoved() || timer.elapsed() > MD_AZIMUTH_START_TIME);
+        default:
+            return false;
+    }
+}
+
+bool MaxDomeIIPollFast(AzStatus azimuth, ShStatus shutter, const MaxDomeIITimer &azimuthTimer,
+                       const MaxDomeIITimer &shutterTimer)
+{
+    return azimuth == AS_MOVING_WE || azimuth == AS_MOVING_EW || shutter == SS_OPENING || shutter == SS_CLOSING ||
+           (azimuthTimer.running() && azimuthTimer.elapsed() <= MD_AZIMUTH_START_TIME) ||
+           (shutterTimer.running() && shutterTimer.elapsed() <= MD_SHUTTER_START_TIME);
+}
+
+void MaxDomeII::SchedulePoll(uint32_t ms)
+{
+    if (nPollTimerID >= 0)
+        RemoveTimer(nPollTimerID);
+    nPollPeriod  = ms;
+    nPollTimerID = SetTimer(ms);
+}
+
+void MaxDomeII::PollSoon()
+{
+    // Before the first TimerHit the polling timer is not ours to replace
+    if (nPollTimerID >= 0)
+        SchedulePoll(MaxDomeIIPollPeriod(true, nPollPeriod, getCurrentPollingPeriod(), 0));
+}
+
 void MaxDomeII::TimerHit()
 {
     ShStatus shutterSt;
@@ -228,15 +306,8 @@ void MaxDomeII::TimerHit()
     nError = driver.Status(&shutterSt, &nAzimuthStatus, &nCurrentTicks, &nHomePosition);
     handle_driver_error(&nError, &nRetry); // This is a timer, we will not repeat in order to not delay the execution.
 
-    // Increment movment time counter
-    if (nTimeSinceShutterStart >= 0)
-        nTimeSinceShutterStart++;
-    if (nTimeSinceAzimuthStart >= 0)
-        nTimeSinceAzimuthStart++;
-
     // Watch dog
-    nTimeSinceLastCommunication++;
-    if (WatchDogNP.np[0].value > 0 && WatchDogNP.np[0].value <= nTimeSinceLastCommunication)
+    if (WatchDogNP.np[0].value > 0 && WatchDogNP.np[0].value <= CommunicationTimer.elapsed())
     {
         // Close Shutter if it is not
         if (shutterSt != SS_CLOSED)
@@ -267,16 +338,16 @@ void MaxDomeII::TimerHit()
                     if (DomeShutterSP.s == IPS_BUSY || DomeShutterSP.s == IPS_ALERT)
                     {
                         DomeShutterSP.s        = IPS_OK; // Shutter close movement ends.
-                        nTimeSinceShutterStart = -1;
+                        ShutterTimer.stop();
                         IDSetSwitch(&DomeShutterSP, "Shutter is closed");
                     }
                 }
                 else
                 {
-                    if (nTimeSinceShutterStart >= 0)
+                    if (ShutterTimer.running())
                     {
                         // A movement has started. Warn but don't change
-                        if (nTimeSinceShutterStart >= 4)
+                        if (ShutterTimer.elapsed() >= MD_SHUTTER_START_TIME)
                         {
                             DomeShutterSP.s = IPS_ALERT; // Shutter close movement ends.
                             IDSetSwitch(&DomeShutterSP, "Shutter still closed");
@@ -301,11 +372,11 @@ void MaxDomeII::TimerHit()
                     DomeShutterS[0].s = ISS_OFF;
                     IDSetSwitch(&DomeShutterSP, "Unexpected shutter opening");
                 }
-                else if (nTimeSinceShutterStart < 0)
+                else if (!ShutterTimer.running())
                 {
                     // For some reason the shutter is opening (manual operation?)
                     DomeShutterSP.s        = IPS_ALERT;
-                    nTimeSinceShutterStart = 0;
+                    ShutterTimer.start();
                     IDSetSwitch(&DomeShutterSP, "Unexpected shutter opening");
                 }
                 else if (DomeShutterSP.s == IPS_ALERT)
@@ -321,16 +392,16 @@ void MaxDomeII::TimerHit()
                     if (DomeShutterSP.s == IPS_BUSY || DomeShutterSP.s == IPS_ALERT)
                     {
                         DomeShutterSP.s        = IPS_OK; // Shutter open movement ends.
-                        nTimeSinceShutterStart = -1;
+                        ShutterTimer.stop();
                         IDSetSwitch(&DomeShutterSP, "Shutter is open");
                     }
                 }
                 else
                 {
-                    if (nTimeSinceShutterStart >= 0)
+                    if (ShutterTimer.running())
                     {
                         // A movement has started. Warn but don't change
-                        if (nTimeSinceShutterStart >= 4)
+                        if (ShutterTimer.elapsed() >= MD_SHUTTER_START_TIME)
                         {
                             DomeShutterSP.s = IPS_ALERT; // Shutter open movement alert.
                             IDSetSwitch(&DomeShutterSP, "Shutter still open");
@@ -355,11 +426,11 @@ void MaxDomeII::TimerHit()
                     DomeShutterS[0].s = ISS_OFF;
                     IDSetSwitch(&DomeShutterSP, "Unexpected shutter closing");
                 }
-                else if (nTimeSinceShutterStart < 0)
+                else if (!ShutterTimer.running())
                 {
                     // For some reason the shutter is opening (manual operation?)
                     DomeShutterSP.s        = IPS_ALERT;
-                    nTimeSinceShutterStart = 0;
+                    ShutterTimer.start();
                     IDSetSwitch(&DomeShutterSP, "Unexpected shutter closing");
                 }
                 else if (DomeShutterSP.s == IPS_ALERT)
@@ -377,12 +448,12 @@ void MaxDomeII::TimerHit()
                 break;
             case SS_ABORTED:
             default:
-                if (nTimeSinceShutterStart >= 0)
+                if (ShutterTimer.running())
                 {
                     DomeShutterSP.s        = IPS_ALERT; // Shutter movement aborted.
                     DomeShutterS[1].s      = ISS_OFF;
                     DomeShutterS[0].s      = ISS_OFF;
-                    nTimeSinceShutterStart = -1;
+                    ShutterTimer.stop();
                     IDSetSwitch(&DomeShutterSP, "Unknown shutter status");
                 }
                 break;
@@ -398,17 +469,18 @@ void MaxDomeII::TimerHit()
             IDSetNumber(&DomeAbsPosNP, nullptr);
         }
 
+        bool azimuthStopped = MaxDomeIIAzimuthStopped(AzimuthTimer, nAzimuthStatus);
         switch (nAzimuthStatus)
         {
             case AS_IDLE:
             case AS_IDLE2:
-                if (nTimeSinceAzimuthStart > 3)
+                if (azimuthStopped)
                 {
                     if (nTargetAzimuth >= 0 &&
                             AzimuthDistance(nTargetAzimuth, nCurrentTicks) > 3) // Maximum difference allowed: 3 ticks
                     {
                         DomeAbsPosNP.s         = IPS_ALERT;
-                        nTimeSinceAzimuthStart = -1;
+                        AzimuthTimer.stop();
                         IDSetNumber(&DomeAbsPosNP, "Could not position right");
                     }
                     else
@@ -417,14 +489,14 @@ void MaxDomeII::TimerHit()
                         if (DomeAbsPosNP.s != IPS_OK)
                         {
                             setDomeState(DOME_SYNCED);
-                            nTimeSinceAzimuthStart = -1;
+                            AzimuthTimer.stop();
                             LOG_INFO("Dome is on target position");
                         }
                         if (HomeS[0].s == ISS_ON)
                         {
                             HomeS[0].s             = ISS_OFF;
                             HomeSP.s               = IPS_OK;
-                            nTimeSinceAzimuthStart = -1;
+                            AzimuthTimer.stop();
                             IDSetSwitch(&HomeSP, "Dome is homed");
                         }
                     }
@@ -432,19 +504,21 @@ void MaxDomeII::TimerHit()
                 break;
             case AS_MOVING_WE:
             case AS_MOVING_EW:
-                if (nTimeSinceAzimuthStart < 0)
+                if (!AzimuthTimer.running())
                 {
-                    nTimeSinceAzimuthStart = 0;
+                    // Already moving, so idle ends this movement
+                    AzimuthTimer.start();
+                    AzimuthTimer.markMoving();
                     nTargetAzimuth         = -1;
                     DomeAbsPosNP.s         = IPS_ALERT;
                     IDSetNumber(&DomeAbsPosNP, "Unexpected dome moving");
                 }
                 break;
             case AS_ERROR:
-                if (nTimeSinceAzimuthStart >= 0)
+                if (AzimuthTimer.running())
                 {
                     DomeAbsPosNP.s         = IPS_ALERT;
-                    nTimeSinceAzimuthStart = -1;
+                    AzimuthTimer.stop();
                     nTargetAzimuth         = -1;
                     IDSetNumber(&DomeAbsPosNP, "Dome Error");
                 }
@@ -455,10 +529,14 @@ void MaxDomeII::TimerHit()
     else
     {
         LOGF_DEBUG("Error: %s. Please reconnect and try again.", ErrorMessages[-nError]);
+        nPollTimerID = -1;
         return;
     }
 
-    SetTimer(getCurrentPollingPeriod());
+    bool moving = MaxDomeIIPollFast(nAzimuthStatus, shutterSt, AzimuthTimer, ShutterTimer);
+    // Poll at least twice per watch dog period
+    uint32_t limit = WatchDogNP.np[0].value > 0 ? static_cast<uint32_t>(WatchDogNP.np[0].value * 500) : 0;
+    SchedulePoll(MaxDomeIIPollPeriod(moving, nPollPeriod, getCurrentPollingPeriod(), limit));
     return;
 }
 
@@ -499,7 +577,8 @@ IPState MaxDomeII::MoveAbs(double newAZ)
         return IPS_ALERT;
 
     nTargetAzimuth = newPos;
-    nTimeSinceAzimuthStart = 0; // Init movement timer
+    AzimuthTimer.start(); // Init movement timer
+    PollSoon();
 
     // It will take a few cycles to reach final position
     return IPS_BUSY;
@@ -528,7 +607,8 @@ IPState MaxDomeII::Move(DomeDirection dir, DomeMotionCommand operation)
             return IPS_ALERT;
 
         nTargetAzimuth = newPos;
-        nTimeSinceAzimuthStart = 0; // Init movement timer
+        AzimuthTimer.start(); // Init movement timer
+        PollSoon();
         return IPS_BUSY;
     }
     else
@@ -545,7 +625,7 @@ IPState MaxDomeII::Move(DomeDirection dir, DomeMotionCommand operation)
 
         DomeAbsPosNP.s = IPS_IDLE;
         IDSetNumber(&DomeAbsPosNP, NULL);
-        nTimeSinceAzimuthStart = -1;
+        AzimuthTimer.stop();
     }
 
     return IPS_OK;
@@ -591,7 +671,7 @@ bool MaxDomeII::ISNewNumber(const char *dev, const char *name, double values[],
     if (strcmp(dev, getDeviceName()))
         return false;
 
-    nTimeSinceLastCommunication = 0;
+    CommunicationTimer.start();
 
     // ===================================
     // TicksPerTurn
@@ -747,7 +827,7 @@ bool MaxDomeII::ISNewSwitch(const char *dev, const char *name, ISState *states,
     if (strcmp(getDeviceName(), dev))
         return false;
 
-    nTimeSinceLastCommunication = 0;
+    CommunicationTimer.start();
 
     // ===================================
     // Home
@@ -765,8 +845,9 @@ bool MaxDomeII::ISNewSwitch(const char *dev, const char *name, ISState *states,
             error = driver.HomeAzimuth();
             handle_driver_error(&error, &nRetry);
         }
-        nTimeSinceAzimuthStart = 0;
-        nTargetAzimuth         = -1;
+        AzimuthTimer.start();
+        nTargetAzimuth = -1;
+        PollSoon();
         if (error)
         {
             LOGF_ERROR("Error Homing Azimuth (%s).", ErrorMessages[-error]);
@@ -956,7 +1037,8 @@ IPState MaxDomeII::ControlShutter(ShutterOperation operation)
             error = driver.CloseShutter();
             handle_driver_error(&error, &nRetry);
         }
-        nTimeSinceShutterStart = 0; // Init movement timer
+        ShutterTimer.start(); // Init movement timer
+        PollSoon();
         if (error)
         {
             LOGF_ERROR("Error closing shutter (%s).", ErrorMessages[-error]);
@@ -974,7 +1056,8 @@ IPState MaxDomeII::ControlShutter(ShutterOperation operation)
                 error = driver.OpenShutter();
                 handle_driver_error(&error, &nRetry);
             }
-            nTimeSinceShutterStart = 0; // Init movement timer
+            ShutterTimer.start(); // Init movement timer
+            PollSoon();
             if (error)
             {
                 LOGF_ERROR("Error opening shutter (%s).", ErrorMessages[-error]);
@@ -990,7 +1073,8 @@ IPState MaxDomeII::ControlShutter(ShutterOperation operation)
                 error = driver.OpenUpperShutterOnly();
                 handle_driver_error(&error, &nRetry);
             }
-            nTimeSinceShutterStart = 0; // Init movement timer
+            ShutterTimer.start(); // Init movement timer
+            PollSoon();
             if (error)
             {
                 LOGF_ERROR("Error opening upper shutter only (%s).", ErrorMessages[-error]);
@@ -25,10 +25,61 @@
 #include <indidome.h>
 #include "maxdomeiidriver.h"
 
+#include <chrono>
+#include <stdint.h>
+
 #define MD_AZIMUTH_IDLE   0
 #define MD_AZIMUTH_MOVING 1
 #define MD_AZIMUTH_HOMING 2
 
+#define MD_POLL_MOVING_MS      250 // Status poll period while azimuth or shutter move
+#define MD_POLL_IDLE_FACTOR    4   // Idle polling backs off up to this multiple of the polling period
+#define MD_AZIMUTH_START_TIME  3.0 // Seconds the azimuth motor may take to start moving
+#define MD_SHUTTER_START_TIME  4.0 // Seconds the shutter may take to start moving
+
+/*
+    Stopwatch on a monotonic clock, independent of the status poll period.
+    Used for movement timeouts and the watch dog.
+*/
+class MaxDomeIITimer
+{
+  public:
+    void start();
+    void stop();
+    bool running() const { return active; }
+    // Seconds since start(), 0 if not running
+    double elapsed() const;
+
+    // Record that the movement has been seen in the status
+    void markMoving() { moved = true; }
+    bool hasMoved() const { return moved; }
+
+  private:
+    bool active { false };
+    bool moved { false };
+    std::chrono::steady_clock::time_point since;
+};
+
+/*
+    Next status poll period in ms. Polls fast while something moves and backs
+    off from the polling period when idle, never beyond limit (0 for none).
+*/
+uint32_t MaxDomeIIPollPeriod(bool moving, uint32_t previous, uint32_t pollingPeriod, uint32_t limit);
+
+/*
+    Follow a commanded azimuth movement with the status of a poll. Marks the
+    timer once the dome is seen moving and returns true when an idle status
+    ends the movement: it was seen moving, or the motor had time to start.
+*/
+bool MaxDomeIIAzimuthStopped(MaxDomeIITimer &timer, AzStatus status);
+
+/*
+    True while the status should be polled fast: the azimuth or shutter move,
+    or a commanded movement may still show up in the status.
+*/
+bool MaxDomeIIPollFast(AzStatus azimuth, ShStatus shutter, const MaxDomeIITimer &azimuthTimer,
+                       const MaxDomeIITimer &shutterTimer);
+
 class MaxDomeII : public INDI::Dome
 {
   public:
@@ -68,6 +119,8 @@ class MaxDomeII : public INDI::Dome
     double TicksToAzimuth(int nTicks);
     int AzimuthToTicks(double nAzimuth);
     int handle_driver_error(int *error, int *nRetry); // Handles errors returned by driver
+    void SchedulePoll(uint32_t ms);
+    void PollSoon(); // Poll fast from now on, after a movement command
 
     ISwitch ShutterModeS[2];
     ISwitchVectorProperty ShutterModeSP;
@@ -100,10 +153,12 @@ class MaxDomeII : public INDI::Dome
     double nParkPosition;        // Park position
     double nHomeAzimuth;         // Azimuth of home position
     int nHomeTicks;              // Ticks from 0 azimuth to home
-    int nTimeSinceShutterStart;  // Timer since shutter movement has started, in order to check timeouts
-    int nTimeSinceAzimuthStart;  // Timer since azimuth movement has started, in order to check timeouts
+    MaxDomeIITimer ShutterTimer;  // Time since shutter movement has started, in order to check timeouts
+    MaxDomeIITimer AzimuthTimer;  // Time since azimuth movement has started, in order to check timeouts
     int nTargetAzimuth;
-    int nTimeSinceLastCommunication; // Used by Watch Dog
+    MaxDomeIITimer CommunicationTimer; // Used by Watch Dog
+    uint32_t nPollPeriod;              // Current status poll period (ms)
+    int nPollTimerID;                  // -1 until TimerHit schedules the polling
 
     double prev_az, prev_alt;
 
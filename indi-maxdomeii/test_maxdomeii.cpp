@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
+#include "maxdomeii.h"
 #include "maxdomeiidriver.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <pty.h>
+#include <poll.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
 
 TEST(MaxDomeIIDriver, hexDump)
 {
@@ -11,6 +21,169 @@ TEST(MaxDomeIIDriver, hexDump)
     ASSERT_STREQ(out, "61 62 63 64");
 }
 
+TEST(MaxDomeII, pollPeriod)
+{
+    // Fast while moving, but never slower than the polling period
+    EXPECT_EQ(MaxDomeIIPollPeriod(true, 4000, 1000, 0), MD_POLL_MOVING_MS);
+    EXPECT_EQ(MaxDomeIIPollPeriod(true, 4000, 100, 0), 100u);
+
+    // Backs off from the polling period when idle
+    uint32_t period = MaxDomeIIPollPeriod(true, 0, 1000, 0);
+    period = MaxDomeIIPollPeriod(false, period, 1000, 0);
+    EXPECT_EQ(period, 1000u);
+    period = MaxDomeIIPollPeriod(false, period, 1000, 0);
+    EXPECT_EQ(period, 2000u);
+    for (int i = 0; i < 10; i++)
+        period = MaxDomeIIPollPeriod(false, period, 1000, 0);
+    EXPECT_EQ(period, 1000u * MD_POLL_IDLE_FACTOR);
+
+    // The watch dog limits the back off
+    EXPECT_EQ(MaxDomeIIPollPeriod(false, 4000, 1000, 1500), 1500u);
+}
+
+TEST(MaxDomeII, timer)
+{
+    MaxDomeIITimer timer;
+    EXPECT_FALSE(timer.running());
+    EXPECT_EQ(timer.elapsed(), 0);
+
+    timer.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(timer.running());
+    EXPECT_GE(timer.elapsed(), 0.05);
+    EXPECT_LT(timer.elapsed(), 1.0);
+    EXPECT_FALSE(timer.hasMoved());
+    timer.markMoving();
+    EXPECT_TRUE(timer.hasMoved());
+
+    timer.stop();
+    EXPECT_FALSE(timer.running());
+    timer.start();
+    EXPECT_FALSE(timer.hasMoved());
+}
+
+// MaxDome II stand-in on a pty: azimuth moves for moveTime after each GOTO
+class DomeSimulator
+{
+    public:
+        explicit DomeSimulator(double moveTime) : moveTime(moveTime)
+        {
+            struct termios raw;
+            memset(&raw, 0, sizeof(raw));
+            cfmakeraw(&raw);
+            openpty(&master, &slave, nullptr, &raw, nullptr);
+            worker = std::thread(&DomeSimulator::run, this);
+        }
+
+        ~DomeSimulator()
+        {
+            running = false;
+            worker.join();
+            close(slave);
+            close(master);
+        }
+
+        int fd() const
+        {
+            return slave;
+        }
+
+        std::chrono::steady_clock::time_point stopTime() const
+        {
+            return moveStart + std::chrono::milliseconds(static_cast<int>(moveTime * 1000));
+        }
+
+        std::atomic<int> statusCommands {0};
+
+    private:
+        void reply(char cmd, const char *data, int len)
+        {
+            char msg[16] = { 0x01, static_cast<char>(len + 2), static_cast<char>(cmd | 0x80) };
+            memcpy(msg + 3, data, len);
+            char checksum = 0;
+            for (int i = 1; i < len + 3; i++)
+                checksum -= msg[i];
+            msg[len + 3] = checksum;
+            if (write(master, msg, len + 4) < 0)
+                return;
+        }
+
+        void run()
+        {
+            char buffer[16];
+            int fill = 0;
+            while (running)
+            {
+                struct pollfd pfd = { master, POLLIN, 0 };
+                if (poll(&pfd, 1, 10) <= 0)
+                    continue;
+                int n = read(master, buffer + fill, sizeof(buffer) - fill);
+                if (n <= 0)
+                    continue;
+                fill += n;
+                if (fill < 2 || fill < buffer[1] + 2)
+                    continue;
+
+                char cmd = buffer[2];
+                fill = 0;
+                if (cmd == 0x05) // GOTO
+                {
+                    moveStart = std::chrono::steady_clock::now();
+                    reply(cmd, nullptr, 0);
+                }
+                else if (cmd == 0x07) // STATUS
+                {
+                    statusCommands++;
+                    bool moving = std::chrono::steady_clock::now() < stopTime();
+                    char status[6] = { SS_CLOSED, static_cast<char>(moving ? AS_MOVING_EW : AS_IDLE), 0, 90, 0, 0 };
+                    reply(cmd, status, sizeof(status));
+                }
+                else
+                    reply(cmd, nullptr, 0);
+            }
+        }
+
+        int master {-1};
+        int slave {-1};
+        double moveTime;
+        std::chrono::steady_clock::time_point moveStart;
+        std::atomic<bool> running {true};
+        std::thread worker;
+};
+
+TEST(MaxDomeII, azimuthSettleLatency)
+{
+    DomeSimulator simulator(1.2);
+    MaxDomeIIDriver driver;
+    driver.SetPortFD(simulator.fd());
+
+    ShStatus shutterSt;
+    AzStatus azimuthSt;
+    unsigned position, home;
+    MaxDomeIITimer azimuth, shutter;
+    uint32_t period = 0;
+
+    ASSERT_EQ(driver.GotoAzimuth(MAXDOMEII_EW_DIR, 90), 0);
+    azimuth.start();
+
+    // Same decisions as MaxDomeII::TimerHit with a 1 s polling period
+    while (true)
+    {
+        ASSERT_EQ(driver.Status(&shutterSt, &azimuthSt, &position, &home), 0);
+        if (MaxDomeIIAzimuthStopped(azimuth, azimuthSt))
+            break;
+        ASSERT_LT(azimuth.elapsed(), 10.0);
+
+        period = MaxDomeIIPollPeriod(MaxDomeIIPollFast(azimuthSt, shutterSt, azimuth, shutter), period, 1000, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(period));
+    }
+
+    double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - simulator.stopTime()).count();
+    EXPECT_LT(latency, MD_POLL_MOVING_MS / 1000.0 + 0.2);
+    // One status every 250 ms over a 1.2 s move, instead of waiting 3 s for the dome to settle
+    EXPECT_LE(simulator.statusCommands, 8);
+}
+
 
 int main(int argc, char **argv)
 {
@@ -27,6 +27,8 @@
 
 #include <math.h>
 
+#include <chrono>
+
 #define TEMP_THRESHOLD  0.2  /* Differential temperature threshold (°C) */
 #define TEMP_COOLER_OFF 100  /* High enough temperature for the camera cooler to turn off (°C) */
 #define MAX_DEVICES     4    /* Max device cameraCount */
@@ -227,6 +229,7 @@ MICCD::MICCD(int camId, bool eth) : FilterInterface(this)
 
 MICCD::~MICCD()
 {
+    joinDownloadThread();
     gxccd_release(cameraHandle);
 }
 
@@ -487,6 +490,7 @@ bool MICCD::Connect()
 
 bool MICCD::Disconnect()
 {
+    joinDownloadThread();
     LOGF_INFO("Disconnected from %s.", name);
     gxccd_release(cameraHandle);
     cameraHandle = nullptr;
@@ -561,6 +565,7 @@ int MICCD::SetTemperature(double temperature)
 
     TemperatureRequest = temperature;
 
+    std::lock_guard<std::mutex> guard(cameraLock);
     if (!isSimulation() && gxccd_set_temperature(cameraHandle, temperature) < 0)
     {
         char errorStr[MAX_ERROR_LEN];
@@ -574,6 +579,10 @@ int MICCD::SetTemperature(double temperature)
 
 bool MICCD::StartExposure(float duration)
 {
+    // Previous download has already signalled ExposureComplete, only wait for the thread to exit
+    joinDownloadThread();
+    abortDownload = false;
+
     imageFrameType = PrimaryCCD.getFrameType();
     useShutter = (imageFrameType == INDI::CCDChip::LIGHT_FRAME || imageFrameType == INDI::CCDChip::FLAT_FRAME);
 
@@ -602,8 +611,12 @@ bool MICCD::StartExposure(float duration)
 
 bool MICCD::AbortExposure()
 {
+    // A frame being downloaded is dropped instead of completed
+    abortDownload = true;
+
     if (InExposure && !isSimulation())
     {
+        std::lock_guard<std::mutex> guard(cameraLock);
         if (gxccd_abort_exposure(cameraHandle, false) < 0)
         {
             char errorStr[MAX_ERROR_LEN];
@@ -614,7 +627,6 @@ bool MICCD::AbortExposure()
     }
 
     InExposure  = false;
-    downloading = false;
     LOG_INFO("Exposure aborted.");
     return true;
 }
@@ -658,12 +670,15 @@ bool MICCD::UpdateCCDBin(int hor, int ver)
                    hor, ver, maxBinX, maxBinY);
         return false;
     }
-    if (gxccd_set_binning(cameraHandle, hor, ver) < 0)
     {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("Setting binning failed: %s.", errorStr);
-        return false;
+        std::lock_guard<std::mutex> guard(cameraLock);
+        if (gxccd_set_binning(cameraHandle, hor, ver) < 0)
+        {
+            char errorStr[MAX_ERROR_LEN];
+            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+            LOGF_ERROR("Setting binning failed: %s.", errorStr);
+            return false;
+        }
     }
     PrimaryCCD.setBin(hor, ver);
     return UpdateCCDFrame(PrimaryCCD.getSubX(), PrimaryCCD.getSubY(), PrimaryCCD.getSubW(), PrimaryCCD.getSubH());
@@ -699,12 +714,15 @@ static void mirror_image(void *buf, size_t w, size_t d)
     }
 }
 
-/* Downloads the image from the CCD. */
+/* Downloads the image from the CCD. Runs in the download thread. */
 int MICCD::grabImage()
 {
+    auto start = std::chrono::steady_clock::now();
+
     std::unique_lock<std::mutex> guard(ccdBufferLock);
     int ret              = 0;
     unsigned char *image = (unsigned char *)PrimaryCCD.getFrameBuffer();
+    size_t size          = PrimaryCCD.getFrameBufferSize();
     int width  = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
     int height = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
 
@@ -718,7 +736,8 @@ int MICCD::grabImage()
     }
     else
     {
-        ret = gxccd_read_image(cameraHandle, image, PrimaryCCD.getFrameBufferSize());
+        std::lock_guard<std::mutex> camera(cameraLock);
+        ret = gxccd_read_image(cameraHandle, image, size);
         if (ret < 0)
         {
             char errorStr[MAX_ERROR_LEN];
@@ -733,15 +752,36 @@ int MICCD::grabImage()
 
     guard.unlock();
 
-    if (ExposureRequest > 5 && !ret)
-        LOG_INFO("Download complete.");
+    if (!ret)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double rate    = seconds > 0 ? size / seconds / (1024.0 * 1024.0) : 0;
+
+        // Don't spam the session log unless it is a long exposure > 5 seconds
+        if (ExposureRequest > 5)
+            LOGF_INFO("Download complete in %.2f s (%.1f MB/s).", seconds, rate);
+        else
+            LOGF_DEBUG("Download complete in %.3f s (%.1f MB/s).", seconds, rate);
+    }
 
     downloading = false;
+    if (abortDownload)
+    {
+        LOG_DEBUG("Download aborted, frame dropped.");
+        return ret;
+    }
     ExposureComplete(&PrimaryCCD);
 
     return ret;
 }
 
+void MICCD::joinDownloadThread()
+{
+    // ExposureComplete may start the next exposure from within the download thread itself
+    if (downloadThread.joinable() && downloadThread.get_id() != std::this_thread::get_id())
+        downloadThread.join();
+}
+
 void MICCD::TimerHit()
 {
     if (!isConnected())
@@ -768,8 +808,9 @@ void MICCD::TimerHit()
             if (ExposureRequest > 5)
                 LOG_INFO("Exposure done, downloading image...");
 
-            // grab and save image
-            grabImage();
+            // grab and save image without blocking the main loop
+            joinDownloadThread();
+            downloadThread = std::thread(&MICCD::grabImage, this);
         }
         // camera may need some time for image download -> update client only for positive values
         else if (timeleft >= 0)
@@ -789,6 +830,7 @@ int MICCD::QueryFilter()
 
 bool MICCD::SelectFilter(int position)
 {
+    std::lock_guard<std::mutex> guard(cameraLock);
     if (!isSimulation() && gxccd_set_filter(cameraHandle, position - 1) < 0)
     {
         char errorStr[MAX_ERROR_LEN];
@@ -805,6 +847,7 @@ bool MICCD::SelectFilter(int position)
 
 IPState MICCD::GuideNorth(uint32_t ms)
 {
+    std::lock_guard<std::mutex> guard(cameraLock);
     if (gxccd_move_telescope(cameraHandle, 0, static_cast<int16_t>(ms)) < 0)
     {
         char errorStr[MAX_ERROR_LEN];
@@ -817,6 +860,7 @@ IPState MICCD::GuideNorth(uint32_t ms)
 
 IPState MICCD::GuideSouth(uint32_t ms)
 {
+    std::lock_guard<std::mutex> guard(cameraLock);
     if (gxccd_move_telescope(cameraHandle, 0, (-1 * static_cast<int16_t>(ms))) < 0)
     {
         char errorStr[MAX_ERROR_LEN];
@@ -829,6 +873,7 @@ IPState MICCD::GuideSouth(uint32_t ms)
 
 IPState MICCD::GuideEast(uint32_t ms)
 {
+    std::lock_guard<std::mutex> guard(cameraLock);
     if (gxccd_move_telescope(cameraHandle, (-1 * static_cast<int16_t>(ms)), 0) < 0)
     {
         char errorStr[MAX_ERROR_LEN];
@@ -841,6 +886,7 @@ IPState MICCD::GuideEast(uint32_t ms)
 
 IPState MICCD::GuideWest(uint32_t ms)
 {
+    std::lock_guard<std::mutex> guard(cameraLock);
     if (gxccd_move_telescope(cameraHandle, static_cast<int16_t>(ms), 0) < 0)
     {
         char errorStr[MAX_ERROR_LEN];
@@ -873,6 +919,7 @@ bool MICCD::ISNewSwitch(const char *dev, const char *name, ISState *states, char
                 bool on = !IUFindOnSwitchIndex(&CoolerSP);
                 double temp = on ? TemperatureRequest : TEMP_COOLER_OFF;
 
+                std::lock_guard<std::mutex> guard(cameraLock);
                 if (gxccd_set_temperature_ramp(cameraHandle, TemperatureRampN[0].value) < 0 ||
                     gxccd_set_temperature(cameraHandle, temp) < 0)
                 {
@@ -918,6 +965,7 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         if (!strcmp(name, FanNP.name))
         {
             IUUpdateNumber(&FanNP, values, names, n);
+            std::lock_guard<std::mutex> guard(cameraLock);
 
             if (!isSimulation() && gxccd_set_fan(cameraHandle, FanN[0].value) < 0)
             {
@@ -938,6 +986,7 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         if (!strcmp(name, WindowHeatingNP.name))
         {
             IUUpdateNumber(&WindowHeatingNP, values, names, n);
+            std::lock_guard<std::mutex> guard(cameraLock);
 
             if (!isSimulation() && gxccd_set_window_heating(cameraHandle, WindowHeatingN[0].value) < 0)
             {
@@ -958,6 +1007,7 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         if (!strcmp(name, TemperatureRampNP.name))
         {
             IUUpdateNumber(&TemperatureRampNP, values, names, n);
+            std::lock_guard<std::mutex> guard(cameraLock);
 
             if (!isSimulation() && gxccd_set_temperature_ramp(cameraHandle, TemperatureRampN[0].value) < 0)
             {
@@ -978,6 +1028,7 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         if (!strcmp(name, PreflashNP.name))
         {
             IUUpdateNumber(&PreflashNP, values, names, n);
+            std::lock_guard<std::mutex> guard(cameraLock);
 
             // set NIR pre-flash if available.
             if (canDoPreflash)
@@ -1002,6 +1053,7 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         if (!strcmp(name, GainNP.name))
         {
             IUUpdateNumber(&GainNP, values, names, n);
+            std::lock_guard<std::mutex> guard(cameraLock);
 
             if (!isSimulation() && gxccd_set_gain(cameraHandle, static_cast<uint16_t>(GainN[0].value)) < 0)
             {
@@ -1047,6 +1099,14 @@ void MICCD::updateTemperature()
     }
     else
     {
+        // Keep polling without waiting for a frame download to finish
+        std::unique_lock<std::mutex> guard(cameraLock, std::try_to_lock);
+        if (!guard.owns_lock())
+        {
+            temperatureID = IEAddTimer(getCurrentPollingPeriod(), MICCD::updateTemperatureHelper, this);
+            return;
+        }
+
         if (gxccd_get_value(cameraHandle, GV_CHIP_TEMPERATURE, &ccdtemp) < 0)
         {
             char errorStr[MAX_ERROR_LEN];
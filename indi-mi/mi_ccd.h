@@ -26,6 +26,10 @@
 #include <indiccd.h>
 #include <indifilterinterface.h>
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 class MICCD : public INDI::CCD, public INDI::FilterInterface
 {
   public:
@@ -113,7 +117,14 @@ class MICCD : public INDI::CCD, public INDI::FilterInterface
     int temperatureID;
     int timerID;
 
-    bool downloading;
+    // Image download runs in its own thread so that temperature and filter
+    // wheel keep being served while large frames are transferred.
+    std::thread downloadThread;
+    std::atomic_bool downloading {false};
+    // Set by AbortExposure, a frame still being downloaded is then not completed
+    std::atomic_bool abortDownload {false};
+    // Serializes the calls on cameraHandle between the main and download threads
+    std::mutex cameraLock;
 
     bool canDoPreflash;
 
@@ -127,6 +138,7 @@ class MICCD : public INDI::CCD, public INDI::FilterInterface
 
     float calcTimeLeft();
     int grabImage();
+    void joinDownloadThread();
 
     void updateTemperature();
     static void updateTemperatureHelper(void *);
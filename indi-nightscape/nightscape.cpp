@@ -415,6 +415,7 @@ bool NightscapeCCD::StartExposure(float duration)
     if (ft == INDI::CCDChip::DARK_FRAME || ft == INDI::CCDChip::BIAS_FRAME) dark = true;
     else dark = false;
     m->senddur(duration, framediv, dark);
+    st->startExposure(duration);
     InExposure = true;
     // We're done
     return true;
@@ -427,6 +428,7 @@ bool NightscapeCCD::AbortExposure()
 {
     InExposure = false;
     AbortFrame = true;
+    st->cancel();
     m->abort();
     return true;
 }
@@ -534,6 +536,7 @@ void NightscapeCCD::TimerHit()
     if (InDownload && !dn->inDownload())
     {
         LOG_INFO( "download done...");
+        LOGF_DEBUG("Camera status polled %d times for this exposure", st->getPolls());
         InDownload = false;
         grabImage();
     }
@@ -574,7 +577,8 @@ void NightscapeCCD::TimerHit()
         case IPS_ALERT:
             break;
     }
-    if (!InReadout && !InDownload)
+    // The status thread polls the camera while an exposure is in progress
+    if (!InExposure && !InReadout && !InDownload)
     {
         int stat = m->rcvstat();
         if (oldstat != stat)
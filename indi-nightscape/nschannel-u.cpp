@@ -1,8 +1,13 @@
 #include <stdio.h>
+#include <chrono>
+#include <thread>
 
 #include "nschannel-u.h"
 #include  "nsdebug.h"
 
+// Latency timer of both channels in ms, a read without data returns after it
+#define LATENCY_TIMER_MS 2
+
 struct ftdi_context * NsChannelU::getDataChannel(void) {
 		return &data_channel;	
 }
@@ -103,7 +108,7 @@ int  NsChannelU::opendownload(void)
        return -1;
     }
     //rc2 = ftdi_set_latency_timer (&ftdid, 255);
-    rc2 = ftdi_set_latency_timer (ftdid, 2);
+    rc2 = ftdi_set_latency_timer (ftdid, LATENCY_TIMER_MS);
     
     if (rc2 < 0)
     {
@@ -179,7 +184,7 @@ int NsChannelU::opencontrol (void)
         DO_ERR( "unable to set baudrate: %d (%s)\n", rc, ftdi_get_error_string(ftdic));
 				return -1;
     }
-    rc=ftdi_set_latency_timer(ftdic, 2);
+    rc=ftdi_set_latency_timer(ftdic, LATENCY_TIMER_MS);
     if (rc  < 0) {
         DO_ERR( "unable to set latency: %d (%s)\n", rc, ftdi_get_error_string(ftdic));
 				return -1;
@@ -228,7 +233,11 @@ int NsChannelU::readCommand(unsigned char *buf, size_t size) {
   int rc;
   struct ftdi_context * ftdic = &command_channel;
 
-  rc = ftdi_read_data(ftdic, buf, size);
+  // ftdi_read_data returns 0 when the latency timer expires without data, so
+  // wait for the reply up to the read timeout like the other backends do.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ftdic->usb_read_timeout);
+  while ((rc = ftdi_read_data(ftdic, buf, size)) == 0 && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(LATENCY_TIMER_MS));
   if (rc < 0) {
    DO_ERR( "unable to read command: %d (%s)\n", rc, ftdi_get_error_string(ftdic));
   	return -1;
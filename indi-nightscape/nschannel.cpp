@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <chrono>
 #include "nschannel.h"
 #include  "nsdebug.h"
 
@@ -19,3 +20,18 @@ int NsChannel::close() {
 int NsChannel::getMaxXfer() {
 		return maxxfer;	
 }
+
+int NsChannel::readResponse(unsigned char * buf, size_t n, int timeout_ms) {
+		// Every backend read waits for data up to its own read timeout, the
+		// libftdi one by retrying at its latency timer, so this does not spin
+		// while the camera is busy.
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+		size_t got = 0;
+		while (got < n) {
+			int rc = readCommand(buf + got, n - got);
+			if (rc < 0) return rc;
+			got += rc;
+			if (got < n && std::chrono::steady_clock::now() >= deadline) break;
+		}
+		return got;
+}
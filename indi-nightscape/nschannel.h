@@ -23,6 +23,8 @@ class NsChannel {
 	
 	  virtual int close();
 		virtual int readCommand(unsigned char * buf, size_t n) = 0;
+		// Read a complete response of n bytes, waiting up to timeout_ms for it
+		int readResponse(unsigned char * buf, size_t n, int timeout_ms);
 		virtual int writeCommand(const unsigned char * buf, size_t n) = 0;
 		virtual int readData(unsigned char * buf, size_t n)= 0;
 		virtual int purgeData(void)= 0;
@@ -226,23 +226,13 @@ float Nsmsg::gettemp(void) {
 
 int Nsmsg::sendcmd (const char * name) {
 		int rc;
-		int hardloop;
     rc=chan->writeCommand(cmd, CMD_SIZE);
 		if (rc != CMD_SIZE) {
      DO_ERR( "unable to write(%s): %d\n", name, rc);
 			chan->resetcontrol();
 			return -1;
 		}
-    usleep(1000);
-		hardloop = 7; 
-		int usec = 1000;
-    while((rc = chan->readCommand(resp, sizeof(resp))) == 0 && hardloop > 0) {
-			if (hardloop % 2 == 0) DO_INFO("CW%d\n",hardloop);
-    			usleep(usec);
-			usec*= 2;
-			//if (usec > 100000) usec = 100000;
-			hardloop--;
-		} 
+    rc = chan->readResponse(resp, sizeof(resp), CMD_TIMEOUT_MS);
    	if (rc != sizeof(resp)) {
     	DO_ERR("unable to read(%s) rc %d\n", name, rc);
 			chan->resetcontrol();
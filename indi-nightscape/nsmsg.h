@@ -2,6 +2,8 @@
 #define __NS_MSG_H__
 
 #define CMD_SIZE 16
+// How long to wait for the camera to answer a command
+#define CMD_TIMEOUT_MS 500
 #include <libftdi1/ftdi.h>
 #include "kaf_constants.h"
 #include"nschannel.h"
@@ -1,5 +1,11 @@
 #include "nsstatus.h"
 #include <unistd.h>
+#include <algorithm>
+
+#define NS_STATUS_SLOW_MS  2000 // keep-alive poll while exposing
+#define NS_STATUS_FAST_MS  33   // poll period around the readout
+#define NS_STATUS_LEAD_MS  500  // start fast polling this long before the expected end
+#define NS_STATUS_CHECK_MS 100  // how often a running download is checked
 
 
 static long long millis()
@@ -34,19 +40,36 @@ void NsStatus::setInterrupted(){
 	go_status.notify_all();
 }
 
-void NsStatus::trun(){
+bool NsStatus::waitUntil(std::unique_lock<std::mutex> &ulock, Clock::time_point t, unsigned seq) {
+	go_status.wait_until(ulock, t, [&] { return interrupted || !do_status || expSeq != seq || kick; });
+	kick = false;
+	return !interrupted && do_status && expSeq == seq;
+}
 
-	do  {
-		DO_INFO("%s\n", "status thread");
-		std::unique_lock<std::mutex> ulock(stmut);
+/*
+ * The camera is only asked for its status as often as the exposure timeline
+ * requires: a slow keep-alive poll while the shutter is open, fast polls from
+ * shortly before the expected end until the readout has finished, and none
+ * while the image is downloaded.
+ */
+void NsStatus::trun(){
+	DO_INFO("%s\n", "status thread");
+	std::unique_lock<std::mutex> ulock(stmut);
 
+	while (!interrupted) {
 		while(!do_status && !interrupted) go_status.wait(ulock);
-			DO_DBG ("%s\n", "status thread wakeup");
-		
+		if (interrupted) break;
+		DO_DBG ("%s\n", "status thread wakeup");
+
+		unsigned seq = expSeq;
 		bool download = false;
 		bool done = false;
-		while (!done&&!interrupted) {
+		Clock::time_point next = Clock::now();
+		while (!done && waitUntil(ulock, next, seq)) {
+			ulock.unlock();
 			status = m->rcvstat();
+			ulock.lock();
+			polls++;
 			if (status < 0) {
 					done = true;
 					DO_ERR("%s\n", "status read failed..");
@@ -62,7 +85,6 @@ void NsStatus::trun(){
 					DO_DBG("%s\n", "download start..");
 				}	
 				download = true;
-				do_status = 0;
 				if(status == 0) done = true;
 					
 			} 
@@ -70,18 +92,57 @@ void NsStatus::trun(){
 						DO_DBG("status change %d\n", status);
 			}
 			old_status = status;
-			usleep(33000);
-			
-			
+
+			if (download && !done) {
+				// Leave the command channel alone until the image has been read
+				while (d->inDownload() && waitUntil(ulock, Clock::now() + std::chrono::milliseconds(NS_STATUS_CHECK_MS), seq));
+			}
+
+			Clock::time_point now = Clock::now();
+			Clock::time_point fast = expEnd - std::chrono::milliseconds(NS_STATUS_LEAD_MS);
+			if (now < fast)
+				next = std::min(now + std::chrono::milliseconds(NS_STATUS_SLOW_MS), fast);
+			else
+				next = now + std::chrono::milliseconds(NS_STATUS_FAST_MS);
 		}
-	} while (!interrupted);
+		if (done) {
+			do_status = 0;
+			DO_INFO("%d status polls for %.3f s exposure\n", polls, expDuration);
+		}
+	}
 	DO_DBG ("%s", "status thread terminated");
 }
 
+void NsStatus::startExposure(float duration) {
+	std::unique_lock<std::mutex> ulock(stmut);
+
+	expDuration = duration;
+	expEnd = Clock::now() + std::chrono::milliseconds((long long)(duration * 1000));
+	expSeq++;
+	polls = 0;
+	do_status = 1;
+	go_status.notify_all();
+}
+
+/* The driver timer says the exposure is over, poll fast from now on */
 void NsStatus::doStatus() {
 	
 	  std::unique_lock<std::mutex> ulock(stmut);
 
+		if (expEnd > Clock::now()) expEnd = Clock::now();
 		do_status = 1;
+		kick = true;
 		go_status.notify_all();
-}
\ No newline at end of file
+}
+
+void NsStatus::cancel() {
+	std::unique_lock<std::mutex> ulock(stmut);
+
+	expSeq++;
+	do_status = 0;
+	go_status.notify_all();
+}
+
+int NsStatus::getPolls() {
+	return polls;
+}
@@ -5,6 +5,7 @@
 #include "nsdebug.h"
 
 #include <condition_variable>
+#include <chrono>
 #include "nsmsg.h"
 #include "nschannel.h"
 #include "nsdownload.h"
@@ -29,19 +30,32 @@ class NsStatus {
 
   }
 	int getStatus();
+	void startExposure(float duration);
 	void doStatus();
+	void cancel();
+	int getPolls();
 	void startThread();
 	void stopThread();
 	
 	private:
+		typedef std::chrono::steady_clock Clock;
 		long long stattime {0};
 		void setInterrupted();
 		void trun();
+		bool waitUntil(std::unique_lock<std::mutex> &ulock, Clock::time_point t, unsigned seq);
 		volatile int status;
 		int old_status;
 		volatile int do_status { 0 };
 		volatile int interrupted;
 
+		// Expected end of the current exposure, and its sequence number so
+		// that a new exposure or an abort restarts the schedule
+		Clock::time_point expEnd;
+		float expDuration { 0 };
+		unsigned expSeq { 0 };
+		bool kick { false };
+		volatile int polls { 0 };
+
 		std::thread * statThread;
 		std::condition_variable go_status;
 		std::mutex stmut;
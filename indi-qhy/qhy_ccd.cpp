@@ -30,6 +30,8 @@
 #include <math.h>
 
 #define TEMP_THRESHOLD       0.05   /* Differential temperature threshold (C)*/
+#define POWER_THRESHOLD      1.0    /* Cooler power change published to clients (%) */
+#define TEMPERATURE_DEFER_MS 100    /* Retry delay of the temperature poll while a frame is read out */
 #define MAX_DEVICES          4     /* Max device cameraCount */
 
 //NB Disable for real driver
@@ -427,6 +429,34 @@ bool QHYCCD::initProperties()
     IUFillTextVector(&GPSDataEndTP, GPSDataEndT, 4, getDeviceName(), "GPS_DATA_END", "End", GPS_DATA_TAB, IP_RO, 60,
                      IPS_IDLE);
 
+    /////////////////////////////////////////////////////////////////////////////
+    /// Properties: Focus Metric
+    /////////////////////////////////////////////////////////////////////////////
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_OFF], "FOCUS_METRIC_OFF", "Off", ISS_ON);
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_LAPLACIAN], "FOCUS_METRIC_LAPLACIAN", "Laplacian variance", ISS_OFF);
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_BRENNER], "FOCUS_METRIC_BRENNER", "Brenner gradient", ISS_OFF);
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_HFR], "FOCUS_METRIC_HFR", "HFR", ISS_OFF);
+    IUFillSwitchVector(&FocusMetricSP, FocusMetricS, 4, getDeviceName(), "CCD_FOCUS_METRIC_MODE", "Metric", FOCUS_METRIC_TAB,
+                       IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+
+    // Zero width or height selects the whole frame
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_X], "X", "Left", "%.f", 0, 16000, 1, 0);
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_Y], "Y", "Top", "%.f", 0, 16000, 1, 0);
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_W], "WIDTH", "Width", "%.f", 0, 16000, 1, 0);
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_H], "HEIGHT", "Height", "%.f", 0, 16000, 1, 0);
+    IUFillNumberVector(&FocusMetricROINP, FocusMetricROIN, 4, getDeviceName(), "CCD_FOCUS_METRIC_ROI", "ROI",
+                       FOCUS_METRIC_TAB, IP_RW, 60, IPS_IDLE);
+
+    IUFillNumber(&FocusMetricN[0], "FOCUS_METRIC_VALUE", "Value", "%.3f", 0, 1e12, 0, 0);
+    IUFillNumberVector(&FocusMetricNP, FocusMetricN, 1, getDeviceName(), "CCD_FOCUS_METRIC", "Focus Metric",
+                       FOCUS_METRIC_TAB, IP_RO, 60, IPS_IDLE);
+
+    /////////////////////////////////////////////////////////////////////////////
+    /// Properties: Guide Centroid
+    /////////////////////////////////////////////////////////////////////////////
+    // Tracking box in frame pixels, it follows the star. Zero size selects the whole frame.
+    GuideCentroidProperties.init(getDeviceName(), "CCD_GUIDE", GUIDE_CENTROID_TAB);
+
     // RAW Data Now
     IUFillText(&GPSDataNowT[GPS_DATA_NOW_FLAG], "GPS_DATA_NOW_FLAG", "Flag", "NA");
     IUFillText(&GPSDataNowT[GPS_DATA_NOW_SEC], "GPS_DATA_NOW_SEC", "Seconds", "NA");
@@ -510,6 +540,15 @@ void QHYCCD::ISGetProperties(const char *dev)
         //NEW CODE - Add support for overscan/calibration area
         if(HasOverscanArea)
             defineProperty(&OverscanAreaSP);
+
+        if (HasStreaming())
+        {
+            defineProperty(&FocusMetricSP);
+            defineProperty(&FocusMetricROINP);
+            defineProperty(&FocusMetricNP);
+        }
+
+        GuideCentroidProperties.define(this);
     }
 }
 
@@ -531,6 +570,7 @@ bool QHYCCD::updateProperties()
             CoolerNP.p = HasCoolerManualMode ? IP_RW : IP_RO;
             defineProperty(&CoolerNP);
 
+            m_PublishedTemperature = m_PublishedPower = NAN;
             m_TemperatureTimerID = IEAddTimer(getCurrentPollingPeriod(), QHYCCD::updateTemperatureHelper, this);
         }
 
@@ -704,6 +744,15 @@ bool QHYCCD::updateProperties()
 
         // Let's get parameters now from CCD
         setupParams();
+
+        if (HasStreaming())
+        {
+            defineProperty(&FocusMetricSP);
+            defineProperty(&FocusMetricROINP);
+            defineProperty(&FocusMetricNP);
+        }
+
+        GuideCentroidProperties.define(this);
     }
     else
     {
@@ -774,6 +823,15 @@ bool QHYCCD::updateProperties()
         //NEW CODE - Add support for overscan/calibration area
         if (HasOverscanArea)
             deleteProperty(OverscanAreaSP.name);
+
+        if (HasStreaming())
+        {
+            deleteProperty(FocusMetricSP.name);
+            deleteProperty(FocusMetricROINP.name);
+            deleteProperty(FocusMetricNP.name);
+        }
+
+        GuideCentroidProperties.remove(this);
     }
 
     return true;
@@ -1280,7 +1338,14 @@ int QHYCCD::SetTemperature(double temperature)
     m_TemperatureRequest = temperature;
     m_PWMRequest = -1;
 
-    SetQHYCCDParam(m_CameraHandle, CONTROL_COOLER, m_TemperatureRequest);
+    // While a frame is read, keep it pending for the next temperature poll
+    {
+        std::unique_lock<std::mutex> transfer(m_TransferLock, std::try_to_lock);
+        if (transfer.owns_lock())
+            sendCoolerSetPoint(CONTROL_COOLER, m_TemperatureRequest);
+        else
+            m_CoolerSetPointPending = true;
+    }
 
     setCoolerEnabled(m_TemperatureRequest <= TemperatureN[0].value);
     setCoolerMode(COOLER_AUTOMATIC);
@@ -1543,6 +1608,9 @@ double QHYCCD::calcTimeLeft()
 /* Downloads the image from the CCD. */
 int QHYCCD::grabImage()
 {
+    // Colour channels of the frame, interleaved when there are several
+    uint32_t channels = 1;
+
     std::unique_lock<std::mutex> guard(ccdBufferLock);
     if (isSimulation())
     {
@@ -1556,11 +1624,14 @@ int QHYCCD::grabImage()
     }
     else
     {
-        uint32_t ret, w, h, bpp, channels;
+        uint32_t ret, w, h, bpp;
 
         LOG_DEBUG("GetQHYCCDSingleFrame Blocking read call.");
+        std::unique_lock<std::mutex> transfer(m_TransferLock);
         ret = GetQHYCCDSingleFrame(m_CameraHandle, &w, &h, &bpp, &channels, PrimaryCCD.getFrameBuffer());
-        LOG_DEBUG("GetQHYCCDSingleFrame Blocking read call complete.");
+        transfer.unlock();
+        LOGF_DEBUG("GetQHYCCDSingleFrame Blocking read call complete, %u control transfers since the last frame.",
+                   m_ControlTransfers.exchange(0));
 
         if (ret != QHYCCD_SUCCESS)
         {
@@ -1583,6 +1654,16 @@ int QHYCCD::grabImage()
     if (HasGPS && GPSControlS[INDI_ENABLED].s == ISS_ON)
         decodeGPSHeader();
 
+    GuideCentroid::Frame star = { PrimaryCCD.getFrameBuffer(), PrimaryCCD.getSubW() / PrimaryCCD.getBinX(),
+                                  PrimaryCCD.getSubH() / PrimaryCCD.getBinY(), static_cast<uint8_t>(PrimaryCCD.getBPP()),
+                                  static_cast<uint8_t>(channels), false };
+    if (GuideCentroidProperties.isEnabled() && !GuideCentroidProperties.update(star))
+    {
+        // Centroid only, the frame is not sent
+        GuideCentroid::completeExposure(this, &PrimaryCCD, "CCD_EXPOSURE");
+        return 0;
+    }
+
     ExposureComplete(&PrimaryCCD);
 
     return 0;
@@ -1731,7 +1812,14 @@ bool QHYCCD::ISNewSwitch(const char *dev, const char *name, ISState *states, cha
                 {
                     m_PWMRequest = 0;
                     m_TemperatureRequest = 30;
-                    SetQHYCCDParam(m_CameraHandle, CONTROL_MANULPWM, 0);
+                    // While a frame is read, keep it pending for the next temperature poll
+                    {
+                        std::unique_lock<std::mutex> transfer(m_TransferLock, std::try_to_lock);
+                        if (transfer.owns_lock())
+                            sendCoolerSetPoint(CONTROL_MANULPWM, 0);
+                        else
+                            m_CoolerSetPointPending = true;
+                    }
 
                     CoolerSP.s = IPS_IDLE;
                     IDSetSwitch(&CoolerSP, nullptr);
@@ -1917,6 +2005,24 @@ bool QHYCCD::ISNewSwitch(const char *dev, const char *name, ISState *states, cha
             IDSetSwitch(&OverscanAreaSP, nullptr);
             return true;
         }
+
+        //////////////////////////////////////////////////////////////////////
+        /// Focus Metric
+        //////////////////////////////////////////////////////////////////////
+        if (!strcmp(name, FocusMetricSP.name))
+        {
+            IUUpdateSwitch(&FocusMetricSP, states, names, n);
+            FocusMetricSP.s = IPS_OK;
+            IDSetSwitch(&FocusMetricSP, nullptr);
+            return true;
+        }
+
+        //////////////////////////////////////////////////////////////////////
+        /// Guide Centroid
+        //////////////////////////////////////////////////////////////////////
+        // The full frame request is served and reset with the next frame
+        if (GuideCentroidProperties.processSwitch(name, states, names, n))
+            return true;
     }
 
     return INDI::CCD::ISNewSwitch(dev, name, states, names, n);
@@ -2207,11 +2313,56 @@ bool QHYCCD::ISNewNumber(const char *dev, const char *name, double values[], cha
             return true;
         }
 
+        //////////////////////////////////////////////////////////////////////
+        /// Focus Metric ROI
+        //////////////////////////////////////////////////////////////////////
+        else if (!strcmp(name, FocusMetricROINP.name))
+        {
+            IUUpdateNumber(&FocusMetricROINP, values, names, n);
+            FocusMetricROINP.s = IPS_OK;
+            IDSetNumber(&FocusMetricROINP, nullptr);
+            return true;
+        }
+
+        //////////////////////////////////////////////////////////////////////
+        /// Guide Centroid Settings
+        //////////////////////////////////////////////////////////////////////
+        else if (GuideCentroidProperties.processNumber(name, values, names, n))
+        {
+            return true;
+        }
+
     }
 
     return INDI::CCD::ISNewNumber(dev, name, values, names, n);
 }
 
+void QHYCCD::updateFocusMetric(const uint8_t *frame, uint32_t w, uint32_t h, uint32_t bpp, uint32_t channels)
+{
+    int method = IUFindOnSwitchIndex(&FocusMetricSP);
+    if (method <= FocusMetric::METHOD_OFF)
+        return;
+
+    FocusMetric::Frame image;
+    image.data     = frame;
+    image.width    = w;
+    image.height   = h;
+    image.bpp      = static_cast<uint8_t>(bpp);
+    image.channels = static_cast<uint8_t>(channels);
+    // Raw bayer frames are measured on same-colour neighbours only
+    image.step     = (HasBayer() && channels == 1) ? 2 : 1;
+
+    FocusMetric::ROI roi;
+    roi.x = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_X].value);
+    roi.y = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_Y].value);
+    roi.w = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_W].value);
+    roi.h = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_H].value);
+
+    FocusMetricN[0].value = FocusMetric::compute(static_cast<FocusMetric::Method>(method), image, roi);
+    FocusMetricNP.s = IPS_OK;
+    IDSetNumber(&FocusMetricNP, nullptr);
+}
+
 void QHYCCD::setCoolerMode(uint8_t mode)
 {
     int currentMode = IUFindOnSwitchIndex(&CoolerModeSP);
@@ -2250,6 +2401,15 @@ void QHYCCD::updateTemperatureHelper(void *p)
     static_cast<QHYCCD *>(p)->updateTemperature();
 }
 
+void QHYCCD::sendCoolerSetPoint(CONTROL_ID control, double value)
+{
+    if (!isSimulation())
+    {
+        SetQHYCCDParam(m_CameraHandle, control, value);
+        m_ControlTransfers++;
+    }
+}
+
 void QHYCCD::updateTemperature()
 {
     double ccdtemp = 0, coolpower = 0;
@@ -2266,27 +2426,35 @@ void QHYCCD::updateTemperature()
     }
     else
     {
-        // Sleep for 1 second before setting temperature/pwm again.
-        //usleep(1000000);
+        // Control transfers slow down the frame download, sample once it is complete.
+        std::unique_lock<std::mutex> transfer(m_TransferLock, std::try_to_lock);
+        if (!transfer.owns_lock())
+        {
+            m_TemperatureTimerID = IEAddTimer(TEMPERATURE_DEFER_MS, QHYCCD::updateTemperatureHelper, this);
+            return;
+        }
 
-        // Call this function as long as we are busy
-        if (TemperatureNP.s == IPS_BUSY)
+        // Call this function as long as we are busy, or a set-point was skipped during a frame download
+        bool pending = m_CoolerSetPointPending;
+        m_CoolerSetPointPending = false;
+        if (TemperatureNP.s == IPS_BUSY || (pending && m_PWMRequest < 0))
         {
-            SetQHYCCDParam(m_CameraHandle, CONTROL_COOLER, m_TemperatureRequest);
+            sendCoolerSetPoint(CONTROL_COOLER, m_TemperatureRequest);
         }
         else if (m_PWMRequest >= 0)
         {
-            SetQHYCCDParam(m_CameraHandle, CONTROL_MANULPWM, m_PWMRequest);
+            sendCoolerSetPoint(CONTROL_MANULPWM, m_PWMRequest);
         }
         // JM 2020-05-18: QHY reported the code below break automatic coolers, so it is only avaiable for manual coolers.
         // Temperature Readout does not work, if we do not set "something", so lets set the current value...
         else if (CoolerModeS[COOLER_MANUAL].s == ISS_ON && TemperatureNP.s == IPS_OK)
         {
-            SetQHYCCDParam(m_CameraHandle, CONTROL_MANULPWM, CoolerN[0].value * 255.0 / 100 );
+            sendCoolerSetPoint(CONTROL_MANULPWM, std::round(CoolerN[0].value * 255.0 / 100));
         }
 
         ccdtemp   = GetQHYCCDParam(m_CameraHandle, CONTROL_CURTEMP);
         coolpower = GetQHYCCDParam(m_CameraHandle, CONTROL_CURPWM);
+        m_ControlTransfers += 2;
     }
 
     // No need to spam to log
@@ -2295,6 +2463,9 @@ void QHYCCD::updateTemperature()
         LOGF_DEBUG("CCD T.: %.f (C) Power: %.f (%.2f%%)", ccdtemp, coolpower, coolpower / 255.0 * 100);
     }
 
+    IPState temperatureState = TemperatureNP.s;
+    IPState coolerState = CoolerNP.s;
+
     TemperatureN[0].value = ccdtemp;
 
     CoolerN[0].value      = coolpower / 255.0 * 100;
@@ -2320,9 +2491,17 @@ void QHYCCD::updateTemperature()
         TemperatureNP.s       = IPS_BUSY;
     }
 
-
-    IDSetNumber(&TemperatureNP, nullptr);
-    IDSetNumber(&CoolerNP, nullptr);
+    // Only publish changes clients can see, NAN forces the first update.
+    if (TemperatureNP.s != temperatureState || !(fabs(TemperatureN[0].value - m_PublishedTemperature) < TEMP_THRESHOLD))
+    {
+        m_PublishedTemperature = TemperatureN[0].value;
+        IDSetNumber(&TemperatureNP, nullptr);
+    }
+    if (CoolerNP.s != coolerState || !(fabs(CoolerN[0].value - m_PublishedPower) < POWER_THRESHOLD))
+    {
+        m_PublishedPower = CoolerN[0].value;
+        IDSetNumber(&CoolerNP, nullptr);
+    }
 
     m_TemperatureTimerID = IEAddTimer(getCurrentPollingPeriod(), QHYCCD::updateTemperatureHelper, this);
 }
@@ -2354,6 +2533,14 @@ bool QHYCCD::saveConfigItems(FILE *fp)
     if (HasAmpGlow)
         IUSaveConfigSwitch(fp, &AMPGlowSP);
 
+    if (HasStreaming())
+    {
+        IUSaveConfigSwitch(fp, &FocusMetricSP);
+        IUSaveConfigNumber(fp, &FocusMetricROINP);
+    }
+
+    GuideCentroidProperties.save(fp);
+
     if (HasGPS)
     {
         IUSaveConfigSwitch(fp, &GPSControlSP);
@@ -2585,18 +2772,31 @@ void QHYCCD::streamVideo()
         uint32_t retries = 0;
         std::unique_lock<std::mutex> guard(ccdBufferLock);
         uint8_t *buffer = PrimaryCCD.getFrameBuffer();
+        std::unique_lock<std::mutex> transfer(m_TransferLock);
         while (retries++ < 10)
         {
-
             ret = GetQHYCCDLiveFrame(m_CameraHandle, &w, &h, &bpp, &channels, buffer);
             if (ret == QHYCCD_ERROR)
                 usleep(1000);
             else
                 break;
         }
+        transfer.unlock();
         guard.unlock();
+
         if (ret == QHYCCD_SUCCESS)
         {
+            // Cooler and telemetry traffic is rare between live frames, only report it
+            uint32_t transfers = m_ControlTransfers.exchange(0);
+            if (transfers > 0)
+                LOGF_DEBUG("%u control transfers since the last live frame.", transfers);
+        }
+        if (ret == QHYCCD_SUCCESS)
+        {
+            if (FocusMetricS[FocusMetric::METHOD_OFF].s != ISS_ON)
+                updateFocusMetric(buffer, w, h, bpp, channels);
+
+            // Preview frames are throttled by the stream manager, the metric is published for every frame
             Streamer->newFrame(buffer, w * h * bpp / 8 * channels);
 
             if (HasGPS && GPSControlS[INDI_ENABLED].s == ISS_ON)
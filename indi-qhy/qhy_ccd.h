@@ -24,8 +24,13 @@
 #include <qhyccd.h>
 #include <indiccd.h>
 #include <indifilterinterface.h>
+#include "focus_metric.h"
+#include "guide_centroid_properties.h"
 #include <unistd.h>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <cmath>
 #include <pthread.h>
 
 #define DEVICE struct usb_device *
@@ -262,6 +267,33 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
             GPS_DATA_END_TS,
         };
 
+        /////////////////////////////////////////////////////////////////////////////
+        /// Properties: Focus Metric
+        /////////////////////////////////////////////////////////////////////////////
+        // Metric computed on every streamed frame
+        ISwitchVectorProperty FocusMetricSP;
+        ISwitch FocusMetricS[4];
+
+        // Region of interest in streamed frame pixels
+        INumberVectorProperty FocusMetricROINP;
+        INumber FocusMetricROIN[4];
+        enum
+        {
+            FOCUS_ROI_X,
+            FOCUS_ROI_Y,
+            FOCUS_ROI_W,
+            FOCUS_ROI_H
+        };
+
+        INumberVectorProperty FocusMetricNP;
+        INumber FocusMetricN[1];
+
+        /////////////////////////////////////////////////////////////////////////////
+        /// Properties: Guide Centroid
+        /////////////////////////////////////////////////////////////////////////////
+        // Publish star centroid instead of full frames
+        GuideCentroid::Properties GuideCentroidProperties;
+
         // GPS Data Now
         ITextVectorProperty GPSDataNowTP;
         IText GPSDataNowT[4] {};
@@ -373,6 +405,7 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         static void *imagingHelper(void *context);
         void *imagingThreadEntry();
         void streamVideo();
+        void updateFocusMetric(const uint8_t *frame, uint32_t w, uint32_t h, uint32_t bpp, uint32_t channels);
         void getExposure();
         void exposureSetRequest(ImageState request);
         int grabImage();
@@ -384,6 +417,8 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         void setCoolerMode(uint8_t mode);
         // Enable/disable cooler
         void setCoolerEnabled(bool enable);
+        // Send cooler set-point (CONTROL_COOLER or CONTROL_MANULPWM), m_TransferLock is held
+        void sendCoolerSetPoint(CONTROL_ID control, double value);
         // Temperature update
         void updateTemperature();
         static void updateTemperatureHelper(void *);
@@ -440,6 +475,16 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         int m_MaxFilterCount { -1 };
         // Temperature Timer
         int m_TemperatureTimerID;
+        // A set-point was requested while a frame was read, send it on the next temperature poll
+        bool m_CoolerSetPointPending { false };
+        // Last published temperature (C) and cooler power (%)
+        double m_PublishedTemperature { NAN };
+        double m_PublishedPower { NAN };
+        // Held while a frame is read from the camera, cooler and telemetry
+        // transfers only run when they can take it without waiting
+        std::mutex m_TransferLock;
+        // Cooler and telemetry control transfers since the last frame
+        std::atomic<uint32_t> m_ControlTransfers { 0 };
         // Camera Handle
         qhyccd_handle *m_CameraHandle {nullptr};
         // Camera Image Frame Type
@@ -481,4 +526,6 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         /////////////////////////////////////////////////////////////////////////////
         static constexpr const char * GPS_CONTROL_TAB = "GPS Control";
         static constexpr const char * GPS_DATA_TAB = "GPS Data";
+        static constexpr const char * FOCUS_METRIC_TAB = "Focus Metric";
+        static constexpr const char * GUIDE_CENTROID_TAB = "Guide Centroid";
 };
@@ -32,16 +32,28 @@
 #include <libnova/julian_day.h>
 #include <libnova/sidereal_time.h>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <unistd.h>
 #include <errno.h>
 #include <time.h>
 #include <string.h>
 #include <pthread.h>
+#include <sys/time.h>
 
 #define MAX_RTKRCV_PARSES     50              // Read 50 streams before giving up
 #define MAX_TIMEOUT_COUNT   5               // Maximum timeout before auto-connect
 
+#define CLOCK_STEP_THRESHOLD  0.5             // Offsets in seconds above which the clock is stepped
+#define CLOCK_STEP_CONFIRM    10              // Consecutive solutions that must agree before stepping
+#define CLOCK_SLEW_DEADBAND   0.002           // Offsets in seconds below which the clock is left alone
+#define CLOCK_ADJUST_INTERVAL 60              // Minimum seconds between clock adjustments
+#define LOCATION_WINDOW       600             // Fixed solutions in the location median
+#define LOCATION_THRESHOLD    0.05            // Meters the median must move before it is published
+#define TIME_REFRESH_INTERVAL 60              // Seconds between time updates with an unchanged location
+#define STATISTICS_INTERVAL   3600            // Seconds between activity reports
+
 // We declare an auto pointer to GPSD.
 static std::unique_ptr<RTKLIB> rtkrcv(new RTKLIB());
 
@@ -86,6 +98,7 @@ void ISSnoopDevice(XMLEle *root)
 RTKLIB::RTKLIB()
 {
     setVersion(RTKLIB_VERSION_MAJOR, RTKLIB_VERSION_MINOR);
+    pthread_mutex_init(&lock, nullptr);
 }
 
 const char *RTKLIB::getDefaultName()
@@ -129,6 +142,15 @@ bool RTKLIB::updateProperties()
     {
         defineProperty(&GPSstatusTP);
 
+        fixLatitudes.clear();
+        fixLongitudes.clear();
+        fixElevations.clear();
+        nextFix = 0;
+        hasPublishedLocation = false;
+        stepConfirmations = 0;
+        lastClockAdjust = std::chrono::steady_clock::time_point();
+        statisticsStart = std::chrono::steady_clock::now();
+
         pthread_create(&rtkThread, nullptr, &RTKLIB::parse_rtkrcv_helper, this);
     }
     else
@@ -143,12 +165,17 @@ IPState RTKLIB::updateGPS()
 {
     IPState rc = IPS_BUSY;
 
+    // Publish when the averaged location moved, and otherwise only refresh the time now and then
     pthread_mutex_lock(&lock);
-    if (locationPending == false && timePending == false)
+    auto now = std::chrono::steady_clock::now();
+    if (hasPublishedLocation && timePending == false &&
+            (locationPending == false || now - lastTimePublish >= std::chrono::seconds(TIME_REFRESH_INTERVAL)))
     {
         rc = IPS_OK;
         locationPending = true;
         timePending = true;
+        lastTimePublish = now;
+        propertyUpdates++;
     }
     pthread_mutex_unlock(&lock);
 
@@ -171,24 +198,140 @@ bool RTKLIB::is_rtkrcv()
     return true;
 }
 
-bool RTKLIB::setSystemTime(time_t& raw_time)
+bool RTKLIB::setSystemTime(double timestamp)
 {
+    time_t raw_time = static_cast<time_t>(timestamp);
+    int rc = 0;
     #ifdef __linux__
         #if defined(__GNU_LIBRARY__)
             #if (__GLIBC__ >= 2) && (__GLIBC_MINOR__ > 30)
                 timespec sTime = {};
                 sTime.tv_sec = raw_time;
-                clock_settime(CLOCK_REALTIME, &sTime);
+                sTime.tv_nsec = static_cast<long>((timestamp - raw_time) * 1e9);
+                rc = clock_settime(CLOCK_REALTIME, &sTime);
             #else
-                stime(&raw_time);
+                rc = stime(&raw_time);
             #endif
         #else
-            stime(&raw_time);
+            rc = stime(&raw_time);
         #endif
     #endif
+    return rc == 0;
+}
+
+/*
+ * Steer the system clock towards the solution time. Offsets are slewed by
+ * the kernel at a bounded rate, and at most once per CLOCK_ADJUST_INTERVAL.
+ * Only offsets too large to slew, seen on CLOCK_STEP_CONFIRM solutions in a
+ * row, step the clock, so a single bad epoch never moves it.
+ */
+void RTKLIB::disciplineClock(double timestamp)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    double offset = timestamp - (now.tv_sec + now.tv_nsec / 1e9);
+
+    if (fabs(offset) >= CLOCK_STEP_THRESHOLD)
+    {
+        if (++stepConfirmations < CLOCK_STEP_CONFIRM)
+            return;
+        stepConfirmations = 0;
+
+        if (setSystemTime(timestamp))
+        {
+            clockSteps++;
+            lastClockAdjust = std::chrono::steady_clock::now();
+            LOGF_INFO("System clock stepped by %.3f seconds.", offset);
+        }
+        else
+            LOGF_DEBUG("Failed to set system clock: %s", strerror(errno));
+        return;
+    }
+
+    stepConfirmations = 0;
+    if (fabs(offset) < CLOCK_SLEW_DEADBAND ||
+            std::chrono::steady_clock::now() - lastClockAdjust < std::chrono::seconds(CLOCK_ADJUST_INTERVAL))
+        return;
+
+    struct timeval delta;
+    delta.tv_sec = static_cast<time_t>(offset);
+    delta.tv_usec = static_cast<suseconds_t>((offset - delta.tv_sec) * 1e6);
+    if (adjtime(&delta, nullptr) == 0)
+    {
+        clockSlews++;
+        LOGF_DEBUG("Slewing system clock by %.1f ms.", offset * 1000);
+    }
+    else
+        LOGF_DEBUG("Failed to slew system clock: %s", strerror(errno));
+    lastClockAdjust = std::chrono::steady_clock::now();
+}
+
+/*
+ * Add a fixed solution to the running window and update the location with
+ * the median of the window when it moved by more than LOCATION_THRESHOLD.
+ * Returns true if the location changed. Called with lock held.
+ */
+bool RTKLIB::averageLocation(const double *location)
+{
+    if (fixLatitudes.size() < LOCATION_WINDOW)
+    {
+        fixLatitudes.push_back(location[0]);
+        fixLongitudes.push_back(location[1]);
+        fixElevations.push_back(location[2]);
+    }
+    else
+    {
+        fixLatitudes[nextFix] = location[0];
+        fixLongitudes[nextFix] = location[1];
+        fixElevations[nextFix] = location[2];
+        nextFix = (nextFix + 1) % LOCATION_WINDOW;
+    }
+
+    auto median = [](std::vector<double> values)
+    {
+        auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    };
+
+    double average[3] = { median(fixLatitudes), median(fixLongitudes), median(fixElevations) };
+
+    if (hasPublishedLocation)
+    {
+        // Meters per degree on a spherical earth is accurate enough for a threshold
+        const double metersPerDegree = 111320.0;
+        double north = (average[0] - publishedLocation[0]) * metersPerDegree;
+        double east = (average[1] - publishedLocation[1]) * metersPerDegree * cos(average[0] * M_PI / 180.0);
+        double up = average[2] - publishedLocation[2];
+        if (sqrt(north * north + east * east + up * up) < LOCATION_THRESHOLD)
+            return false;
+    }
+
+    std::copy(average, average + 3, publishedLocation);
+    hasPublishedLocation = true;
+
+    LocationN[LOCATION_LATITUDE].value  = average[0];
+    LocationN[LOCATION_LONGITUDE].value = average[1];
+    LocationN[LOCATION_ELEVATION].value = average[2];
+    if (LocationN[LOCATION_LONGITUDE].value < 0)
+        LocationN[LOCATION_LONGITUDE].value += 360;
+
+    locationUpdates++;
     return true;
 }
 
+void RTKLIB::reportStatistics()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - statisticsStart < std::chrono::seconds(STATISTICS_INTERVAL))
+        return;
+
+    LOGF_INFO("Last hour: %u solutions, %u clock slews, %u clock steps, %u location changes, %u property updates.",
+              solutionCount, clockSlews, clockSteps, locationUpdates, propertyUpdates);
+    solutionCount = clockSlews = clockSteps = locationUpdates = propertyUpdates = 0;
+    statisticsStart = now;
+}
+
 void* RTKLIB::parse_rtkrcv_helper(void *obj)
 {
     static_cast<RTKLIB*>(obj)->parse_rtkrcv();
@@ -277,34 +420,26 @@ void RTKLIB::parse_rtkrcv()
             break;
             case status_fix:
             {
-                LocationN[LOCATION_LATITUDE].value  = enu[0];
-                LocationN[LOCATION_LONGITUDE].value = enu[1];
-                LocationN[LOCATION_ELEVATION].value = enu[2];
-                if (LocationN[LOCATION_LONGITUDE].value < 0)
-                    LocationN[LOCATION_LONGITUDE].value += 360;
-
-                struct timespec timesp;
-                time_t raw_time;
                 struct tm *utc, *local;
+                time_t raw_time = (time_t)timestamp;
+
+                solutionCount++;
+                disciplineClock(timestamp);
 
-                timesp.tv_sec = (time_t)timestamp;
-                timesp.tv_nsec = (time_t)(timestamp*1000000000.0);
+                pthread_mutex_lock(&lock);
+                if (averageLocation(enu))
+                    locationPending = false;
 
-                raw_time = timesp.tv_sec;
                 utc = gmtime(&raw_time);
                 strftime(ts, 32, "%Y-%m-%dT%H:%M:%S", utc);
                 IUSaveText(&TimeT[0], ts);
 
-                setSystemTime(raw_time);
-
                 local = localtime(&raw_time);
                 snprintf(ts, 32, "%4.2f", (local->tm_gmtoff / 3600.0));
                 IUSaveText(&TimeT[1], ts);
 
-                pthread_mutex_lock(&lock);
-                locationPending = false;
                 timePending = false;
-                LOG_DEBUG("Threaded Location and Time updates complete.");
+                reportStatistics();
                 pthread_mutex_unlock(&lock);
                 break;
 
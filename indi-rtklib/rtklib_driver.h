@@ -26,6 +26,9 @@
 
 #include <indigps.h>
 
+#include <chrono>
+#include <vector>
+
 class RTKLIB : public INDI::GPS
 {
   public:
@@ -36,7 +39,7 @@ class RTKLIB : public INDI::GPS
     ITextVectorProperty GPSstatusTP;
 
     static void* parse_rtkrcv_helper(void *);
-    virtual bool setSystemTime(time_t& raw_time);
+    virtual bool setSystemTime(double timestamp);
 
   protected:    
     //  Generic indi device entries
@@ -49,11 +52,29 @@ private:
     Connection::TCP *tcpConnection { nullptr };
     bool is_rtkrcv();
     void parse_rtkrcv();
+    void disciplineClock(double timestamp);
+    bool averageLocation(const double *location);
+    void reportStatistics();
 
     int PortFD { -1 };
     uint8_t timeoutCounter=0;
     bool locationPending = true, timePending=true;
 
+    // Clock discipline: small offsets are slewed, large ones stepped once confirmed
+    std::chrono::steady_clock::time_point lastClockAdjust;
+    int stepConfirmations { 0 };
+
+    // Recent fixed solutions, the published location is their median
+    std::vector<double> fixLatitudes, fixLongitudes, fixElevations;
+    size_t nextFix { 0 };
+    double publishedLocation[3] {};
+    bool hasPublishedLocation { false };
+    std::chrono::steady_clock::time_point lastTimePublish;
+
+    // Activity counters, logged every hour
+    std::chrono::steady_clock::time_point statisticsStart;
+    uint32_t solutionCount { 0 }, clockSlews { 0 }, clockSteps { 0 }, locationUpdates { 0 }, propertyUpdates { 0 };
+
     pthread_mutex_t lock;
     pthread_t rtkThread;
 };
@@ -29,18 +29,16 @@
 #include <indilogger.h>
 #include <memory>
 #include <indicom.h>
+#include <algorithm>
+#include <errno.h>
+#include <poll.h>
 
-#define min(a, b)               \
-    ({                          \
-        __typeof__(a) _a = (a); \
-        __typeof__(b) _b = (b); \
-        _a < _b ? _a : _b;      \
-    })
 #define MAX_TRIES      20
 #define SUBFRAME_SIZE  (16384)
 #define MIN_FRAME_SIZE (512)
 #define MAX_FRAME_SIZE (SUBFRAME_SIZE * 16)
 #define SPECTRUM_SIZE  (256)
+#define READ_SIZE      (SUBFRAME_SIZE * 4) /* bytes per USB transfer or socket read */
 
 static int iNumofConnectedSpectrographs;
 static RTLSDR **receivers;
@@ -58,34 +56,163 @@ static void cleanup()
     }
 }
 
-void RTLSDR::Callback()
+static void rtlsdrCallback(unsigned char *buf, uint32_t len, void *ctx)
 {
-    b_read  = 0;
-    to_read = getSampleRate() * IntegrationRequest * getBPS() / 8;
-    setBufferSize(to_read);
+    RTLSDR *receiver = static_cast<RTLSDR *>(ctx);
+    if (!receiver->readerRunning)
+    {
+        rtlsdr_cancel_async(receiver->rtl_dev);
+        return;
+    }
+    receiver->feedSamples(buf, len);
+}
 
-    int len            = min(MAX_FRAME_SIZE, to_read);
-    int olen           = 0;
-    unsigned char *buf = (unsigned char *)malloc(len);
+void RTLSDR::readSamples()
+{
     if((getSensorConnection() & CONNECTION_TCP) == 0)
+    {
+        // Only once per connection, after this the stream is read without gaps
         rtlsdr_reset_buffer(rtl_dev);
-    else
-        tcflush(PortFD, TCOFLUSH);
-    setIntegrationTime(IntegrationRequest);
-    while (InIntegration)
+        int r = rtlsdr_read_async(rtl_dev, rtlsdrCallback, this, 0, READ_SIZE);
+        if (r < 0 && readerRunning)
+            LOGF_ERROR("Sample stream stopped (%d).", r);
+        readerDone = true;
+        return;
+    }
+
+    // rtl_tcp starts with a 12 byte dongle information header
+    std::vector<uint8_t> buf(READ_SIZE);
+    size_t header = 0;
+    bool first = true;
+    while (readerRunning)
     {
-        if((getSensorConnection() & CONNECTION_TCP) == 0)
-            rtlsdr_read_sync(rtl_dev, buf, len, &olen);
+        struct pollfd pfd = { PortFD, POLLIN, 0 };
+        int rc = poll(&pfd, 1, 100);
+        if (rc < 0 && errno != EINTR)
+        {
+            LOGF_ERROR("Failed to wait for samples (%s).", strerror(errno));
+            break;
+        }
+        if (rc <= 0)
+            continue;
+
+        ssize_t n = read(PortFD, buf.data(), buf.size());
+        if (n <= 0)
+        {
+            LOG_ERROR("rtl_tcp connection lost.");
+            break;
+        }
+        if (first && n >= 4 && memcmp(buf.data(), "RTL0", 4) == 0)
+            header = 12;
+        first = false;
+
+        size_t skip = std::min(header, static_cast<size_t>(n));
+        header -= skip;
+        feedSamples(buf.data() + skip, n - skip);
+    }
+    readerDone = true;
+}
+
+void RTLSDR::feedSamples(const uint8_t *data, size_t len)
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    while (len > 0 && InIntegration)
+    {
+        size_t n = std::min(len, frame.size() - frameFill);
+        memcpy(frame.data() + frameFill, data, n);
+        frameFill += n;
+        data += n;
+        len -= n;
+        if (frameFill < frame.size())
+            break;
+
+        bool isStream = streamPredicate;
+        if (framePending)
+        {
+            // The previous frame is still being delivered, this one is lost
+            framesDropped++;
+            samplesDropped += frame.size() / bytesPerSample;
+        }
         else
-            olen = read(PortFD, buf, len);
-        if(olen < 0 )
-            AbortIntegration();
-        else {
-            buffer = buf;
-            n_read = olen;
-            grabData();
+        {
+            std::swap(frame, pendingFrame);
+            pendingIsStream = isStream;
+            framePending = true;
+            frameReady.notify_one();
+        }
+
+        // While streaming the next frame starts with the very next sample
+        frameFill = 0;
+        if (isStream)
+        {
+            frame.resize(frameBytes);
+            gettimeofday(&IntStart, nullptr);
         }
+        else
+            InIntegration = false;
+    }
+}
+
+void RTLSDR::deliverFrames()
+{
+    std::vector<uint8_t> data;
+    std::unique_lock<std::mutex> lock(frameMutex);
+    while (true)
+    {
+        frameReady.wait(lock, [this]() { return framePending || !readerRunning; });
+        if (!readerRunning)
+            break;
+
+        std::swap(data, pendingFrame);
+        bool isStream = pendingIsStream;
+        framePending  = false;
+        lock.unlock();
+
+        if (getBufferSize() != static_cast<int>(data.size()))
+            setBufferSize(data.size());
+        memcpy(getBuffer(), data.data(), data.size());
+        if (isStream)
+            Streamer->newFrame(getBuffer(), data.size());
+        else
+        {
+            LOG_INFO("Download complete.");
+            IntegrationComplete();
+        }
+
+        lock.lock();
+        framesDelivered++;
+    }
+}
+
+void RTLSDR::startReader()
+{
+    framePending   = false;
+    readerDone     = false;
+    readerRunning  = true;
+    readerThread   = std::thread(&RTLSDR::readSamples, this);
+    deliveryThread = std::thread(&RTLSDR::deliverFrames, this);
+}
+
+void RTLSDR::stopReader()
+{
+    if (!readerThread.joinable())
+        return;
+
+    readerRunning = false;
+    // read_async only returns once cancelled, which it ignores until it has started
+    while (!readerDone)
+    {
+        if((getSensorConnection() & CONNECTION_TCP) == 0)
+            rtlsdr_cancel_async(rtl_dev);
+        usleep(10000);
+    }
+    readerThread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        frameReady.notify_all();
     }
+    deliveryThread.join();
 }
 
 void ISInit()
@@ -228,6 +355,11 @@ RTLSDR::RTLSDR(int32_t index)
 
 }
 
+RTLSDR::~RTLSDR()
+{
+    stopReader();
+}
+
 bool RTLSDR::Connect()
 {
     if((getSensorConnection() & CONNECTION_TCP) == 0) {
@@ -237,6 +369,8 @@ bool RTLSDR::Connect()
             LOGF_ERROR("Failed to open rtlsdr device index %d.", spectrographIndex);
             return false;
         }
+        streamPredicate = 0;
+        startReader();
     }
     return true;
 }
@@ -246,6 +380,7 @@ bool RTLSDR::Connect()
 bool RTLSDR::Disconnect()
 {
     InIntegration = false;
+    stopReader();
     if((getSensorConnection() & CONNECTION_TCP) == 0) {
         rtlsdr_close(rtl_dev);
     }
@@ -285,6 +420,12 @@ bool RTLSDR::initProperties()
     setMinMaxStep("SPECTROGRAPH_SETTINGS", "SPECTROGRAPH_BITSPERSAMPLE", 16, 16, 0, false);
     setIntegrationFileExtension("fits");
 
+    IUFillNumber(&StreamStatsN[0], "FRAMES", "Frames", "%.f", 0, 1e12, 0, 0);
+    IUFillNumber(&StreamStatsN[1], "DROPPED_FRAMES", "Dropped frames", "%.f", 0, 1e12, 0, 0);
+    IUFillNumber(&StreamStatsN[2], "DROPPED_SAMPLES", "Dropped samples", "%.f", 0, 1e15, 0, 0);
+    IUFillNumberVector(&StreamStatsNP, StreamStatsN, 3, getDeviceName(), "SPECTROGRAPH_STREAM_STATS", "Frames",
+                       MAIN_CONTROL_TAB, IP_RO, 60, IPS_IDLE);
+
     // Add Debug, Simulator, and Configuration controls
     addAuxControls();
 
@@ -306,9 +447,15 @@ bool RTLSDR::updateProperties()
         // Inital values
         setupParams(1000000, 1420000000, 10);
 
+        defineProperty(&StreamStatsNP);
+
         // Start the timer
         SetTimer(getCurrentPollingPeriod());
     }
+    else
+    {
+        deleteProperty(StreamStatsNP.name);
+    }
 
     return true;
 }
@@ -406,17 +553,21 @@ bool RTLSDR::ISNewNumber(const char *dev, const char *name, double values[], cha
 bool RTLSDR::StartIntegration(double duration)
 {
     IntegrationRequest = static_cast<float>(duration);
-    AbortIntegration();
+
+    {
+        // The reader fills the frame from the next block of samples on
+        std::lock_guard<std::mutex> lock(frameMutex);
+        bytesPerSample = std::max(getBPS() / 8, 1);
+        frameBytes     = static_cast<size_t>(getSampleRate() * duration) * bytesPerSample;
+        frame.resize(frameBytes);
+        frameFill      = 0;
+        gettimeofday(&IntStart, nullptr);
+        InIntegration  = frameBytes > 0;
+    }
+    setIntegrationTime(IntegrationRequest);
 
     LOG_INFO("Integration started...");
-    // Run threads
-    std::thread(&RTLSDR::Callback, this).detach();
-    gettimeofday(&IntStart, nullptr);
-    InIntegration = true;
     return true;
-
-    // We're done
-    return false;
 }
 
 /**************************************************************************************
@@ -424,10 +575,9 @@ bool RTLSDR::StartIntegration(double duration)
 ***************************************************************************************/
 bool RTLSDR::AbortIntegration()
 {
-    if (InIntegration)
-    {
-        InIntegration = false;
-    }
+    std::lock_guard<std::mutex> lock(frameMutex);
+    InIntegration = false;
+    frameFill     = 0;
     return true;
 }
 
@@ -473,45 +623,33 @@ void RTLSDR::TimerHit()
         setIntegrationLeft(timeleft);
     }
 
-    SetTimer(getCurrentPollingPeriod());
-    return;
-}
-
-/**************************************************************************************
-** Create the spectrum
-***************************************************************************************/
-void RTLSDR::grabData()
-{
-    if (InIntegration)
     {
-        n_read    = min(to_read, n_read);
-        continuum = getBuffer();
-        if (n_read > 0)
+        std::lock_guard<std::mutex> lock(frameMutex);
+        if (framesDelivered + framesDropped != framesPublished)
         {
-            memcpy(continuum + b_read, buffer, n_read);
-            b_read += n_read;
-            to_read -= n_read;
-        }
-
-        if (to_read <= 0)
-        {
-            InIntegration = false;
-            if(!streamPredicate) {
-                LOG_INFO("Download complete.");
-                IntegrationComplete();
-            } else {
-                StartIntegration(1.0 / Streamer->getTargetFPS());
-                int32_t size = getBufferSize();
-                Streamer->newFrame(getBuffer(), size);
-            }
+            framesPublished = framesDelivered + framesDropped;
+            StreamStatsN[0].value = framesDelivered;
+            StreamStatsN[1].value = framesDropped;
+            StreamStatsN[2].value = samplesDropped;
+            StreamStatsNP.s = framesDropped > 0 ? IPS_ALERT : IPS_OK;
+            IDSetNumber(&StreamStatsNP, nullptr);
         }
     }
+
+    SetTimer(getCurrentPollingPeriod());
+    return;
 }
 
 //Streamer API functions
 
 bool RTLSDR::StartStreaming()
 {
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        framesDelivered = framesDropped = framesPublished = 0;
+        samplesDropped  = 0;
+    }
+
     pthread_mutex_lock(&condMutex);
     streamPredicate = 1;
     StartIntegration(1.0 / Streamer->getTargetFPS());
@@ -528,6 +666,8 @@ bool RTLSDR::StopStreaming()
     pthread_mutex_unlock(&condMutex);
     pthread_cond_signal(&cv);
 
+    // Otherwise the frame in progress would complete as an integration
+    AbortIntegration();
     return true;
 }
 
@@ -542,6 +682,8 @@ bool RTLSDR::Handshake()
 
     streamPredicate = 0;
     terminateThread = false;
+    if(getSensorConnection() & CONNECTION_TCP)
+        startReader();
     LOG_INFO("RTL-SDR Spectrograph connected successfully!");
     // Let's set a timer that checks teleSpectrographs status every POLLMS milliseconds.
     // JM 2017-07-31 SetTimer already called in updateProperties(). Just call it once
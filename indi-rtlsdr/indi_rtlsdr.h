@@ -27,6 +27,12 @@
 #include "indispectrograph.h"
 #include "stream/streammanager.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 enum Settings
 {
     FREQUENCY_N = 0,
@@ -38,14 +44,15 @@ class RTLSDR : public INDI::Spectrograph
 {
   public:
     RTLSDR(int32_t index);
+    ~RTLSDR();
 
-    void grabData();
+    /** Append a block of the continuous sample stream to the frame being captured */
+    void feedSamples(const uint8_t *data, size_t len);
     rtlsdr_dev_t *rtl_dev = { nullptr };
-    int to_read;
     // Are we integrating?
-    bool InIntegration;
-    uint8_t *buffer;
-    int b_read, n_read;
+    std::atomic<bool> InIntegration;
+    // Set while the reader runs, the USB callback cancels the transfers once it is cleared
+    std::atomic<bool> readerRunning { false };
     bool ISNewNumber(const char *dev, const char *name, double values[], char *names[], int n) override;
 
   protected:
@@ -69,7 +76,33 @@ class RTLSDR : public INDI::Spectrograph
     bool Handshake() override;
 
   private:
-    void Callback();
+    // The reader runs for the whole connection and slices the sample stream
+    // into back to back frames, which the delivery thread hands to INDI.
+    void startReader();
+    void stopReader();
+    void readSamples();
+    void deliverFrames();
+
+    std::thread readerThread;
+    std::thread deliveryThread;
+    std::atomic<bool> readerDone { true };
+    std::mutex frameMutex;
+    std::condition_variable frameReady;
+    std::vector<uint8_t> frame;        // filled by the reader
+    size_t frameFill { 0 };
+    size_t frameBytes { 0 };
+    size_t bytesPerSample { 2 };
+    std::vector<uint8_t> pendingFrame; // complete, waiting for delivery
+    bool framePending { false };
+    bool pendingIsStream { false };
+
+    // Frames lost because the previous one was still being delivered
+    uint32_t framesDelivered { 0 };
+    uint32_t framesDropped { 0 };
+    uint64_t samplesDropped { 0 };
+    uint32_t framesPublished { 0 };
+    INumber StreamStatsN[3];
+    INumberVectorProperty StreamStatsNP;
 
     // Utility functions
     float CalcTimeLeft();
@@ -77,8 +110,6 @@ class RTLSDR : public INDI::Spectrograph
     // Struct to keep timing
     struct timeval IntStart;
     float IntegrationRequest;
-    uint8_t *continuum;
-
     int32_t spectrographIndex = { 0 };
 
     int streamPredicate;
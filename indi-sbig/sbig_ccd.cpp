@@ -47,6 +47,9 @@
 #define MAX_RESOLUTION      4096 /* Maximum resolution for secondary chip */
 #define MAX_DEVICES         20   /* Max device cameraCount */
 #define MAX_THREAD_RETRIES  3
+#define READOUT_BAND_LINES  32   /* Main chip lines read between other driver commands */
+#define READOUT_POLL_MS     100  /* Timer period while the main chip is read out */
+#define GUIDE_RESTART_MS    60000 /* Longer guide frame intervals are pauses of guiding */
 #define MAX_THREAD_WAIT     300000
 
 static int cameraCount;
@@ -398,6 +401,9 @@ SBIGCCD::SBIGCCD() : FilterInterface(this)
 
 SBIGCCD::~SBIGCCD()
 {
+    abortReadout = true;
+    if (readoutThread.joinable())
+        readoutThread.join();
     CloseDevice();
     CloseDriver();
 }
@@ -960,6 +966,12 @@ bool SBIGCCD::Disconnect()
     pthread_cond_signal(&cv);
     pthread_mutex_unlock(&condMutex);
 #endif
+    // The readout stops at its next band of lines
+    abortReadout = true;
+    if (readoutThread.joinable())
+        readoutThread.join();
+    mainReadout = readoutFinished = false;
+    pendingExposure = pendingGuideExposure = false;
     if (FilterConnectionS[0].s == ISS_ON)
         CFWDisconnect();
     if (CloseDevice() == CE_NO_ERROR)
@@ -1149,9 +1161,9 @@ int SBIGCCD::StartExposure(INDI::CCDChip *targetChip, double duration)
 
     for (int i = 0; i < MAX_THREAD_RETRIES; i++)
     {
-        std::unique_lock<std::mutex> guard(sbigLock);
+        std::unique_lock<std::mutex> guard = lockDriver();
         res = StartExposure(&sep);
-        guard.unlock();
+        unlockDriver(guard);
         if (res == CE_NO_ERROR)
         {
             targetChip->setExposureDuration(duration);
@@ -1188,6 +1200,14 @@ bool SBIGCCD::StartExposure(float duration)
 {
     ExposureRequest = duration;
 
+    // The imaging CCD must see the EndReadout of the previous frame first
+    if (mainReadout)
+    {
+        LOG_DEBUG("Primary camera readout in progress, exposure queued.");
+        pendingExposure = true;
+        return true;
+    }
+
     if (duration >= 3)
         LOGF_INFO("Taking %.2fs exposure on main camera...", ExposureRequest);
 
@@ -1207,6 +1227,18 @@ bool SBIGCCD::StartGuideExposure(float duration)
 {
     GuideExposureRequest = duration;
 
+    // The tracking CCD shares the mechanical shutter with the imaging CCD, which
+    // stays closed while the main chip is read out. A light frame taken now would
+    // be dark, so it is started once the readout is completed.
+    int shutter = SC_CLOSE_SHUTTER;
+    if (mainReadout && !m_useExternalTrackingCCD && getShutterMode(&GuideCCD, shutter) == CE_NO_ERROR &&
+            shutter == SC_OPEN_SHUTTER)
+    {
+        LOG_DEBUG("Primary camera readout in progress, guide head exposure queued.");
+        pendingGuideExposure = true;
+        return true;
+    }
+
     if (duration >= 3)
         LOGF_INFO("Taking %.2fs exposure on guide head...", GuideExposureRequest);
 
@@ -1235,9 +1267,9 @@ int SBIGCCD::AbortExposure(INDI::CCDChip *targetChip)
     }
     EndExposureParams eep;
     eep.ccd = ccd;
-    std::unique_lock<std::mutex> guard(sbigLock);
+    std::unique_lock<std::mutex> guard = lockDriver();
     int res = EndExposure(&eep);
-    guard.unlock();
+    unlockDriver(guard);
     return res;
 }
 
@@ -1245,6 +1277,13 @@ bool SBIGCCD::AbortExposure()
 {
     int res = CE_NO_ERROR;
     LOG_DEBUG("Aborting primary camera exposure...");
+    pendingExposure = false;
+    if (mainReadout)
+    {
+        abortReadout = true;
+        InExposure = false;
+        return true;
+    }
     for (int i = 0; i < MAX_THREAD_RETRIES; i++)
     {
         res = AbortExposure(&PrimaryCCD);
@@ -1268,6 +1307,12 @@ bool SBIGCCD::AbortGuideExposure()
 {
     int res = CE_NO_ERROR;
     LOG_DEBUG("Aborting guide head exposure...");
+    if (pendingGuideExposure)
+    {
+        pendingGuideExposure = false;
+        LOG_DEBUG("Guide head exposure aborted");
+        return true;
+    }
     for (int i = 0; i < MAX_THREAD_RETRIES; i++)
     {
         res = AbortExposure(&GuideCCD);
@@ -1495,6 +1540,20 @@ void *SBIGCCD::grabCCD()
 #endif
 
 bool SBIGCCD::grabImage(INDI::CCDChip *targetChip)
+{
+    if (readoutImage(targetChip) == false)
+        return false;
+    if (targetChip == &PrimaryCCD && abortReadout)
+    {
+        LOG_DEBUG("Primary camera readout aborted");
+        return true;
+    }
+    LOGF_DEBUG("%s readout complete", targetChip == &PrimaryCCD ? "Primary camera" : "Guide head");
+    ExposureComplete(targetChip);
+    return true;
+}
+
+bool SBIGCCD::readoutImage(INDI::CCDChip *targetChip)
 {
     uint16_t left   = targetChip->getSubX() / targetChip->getBinX();
     uint16_t top    = targetChip->getSubY() / targetChip->getBinX();
@@ -1533,8 +1592,6 @@ bool SBIGCCD::grabImage(INDI::CCDChip *targetChip)
             return false;
         }
     }
-    LOGF_DEBUG("%s readout complete", targetChip == &PrimaryCCD ? "Primary camera" : "Guide head");
-    ExposureComplete(targetChip);
     return true;
 }
 
@@ -1562,6 +1619,9 @@ void SBIGCCD::TimerHit()
         return;
     }
 
+    if (mainReadout && readoutFinished)
+        finishMainReadout();
+
     if (InExposure)
     {
         targetChip = &PrimaryCCD;
@@ -1572,8 +1632,7 @@ void SBIGCCD::TimerHit()
             LOG_DEBUG("Primay camera exposure done, downloading image...");
             targetChip->setExposureLeft(0);
             InExposure = false;
-            if (grabImage(targetChip) == false)
-                targetChip->setExposureFailed();
+            startMainReadout();
         }
         else
         {
@@ -1594,6 +1653,8 @@ void SBIGCCD::TimerHit()
             InGuideExposure = false;
             if (grabImage(targetChip) == false)
                 targetChip->setExposureFailed();
+            else
+                updateGuideCycle();
         }
         else
         {
@@ -1602,7 +1663,7 @@ void SBIGCCD::TimerHit()
         }
     }
 
-    SetTimer(getCurrentPollingPeriod());
+    SetTimer(mainReadout ? std::min<uint32_t>(READOUT_POLL_MS, getCurrentPollingPeriod()) : getCurrentPollingPeriod());
     return;
 }
 
@@ -2463,9 +2524,9 @@ void SBIGCCD::updateTemperature()
     bool enabled;
     double ccdTemp, setpointTemp, percentTE, power;
 
-    std::unique_lock<std::mutex> guard(sbigLock);
+    std::unique_lock<std::mutex> guard = lockDriver();
     int res = QueryTemperatureStatus(enabled, ccdTemp, setpointTemp, percentTE);
-    guard.unlock();
+    unlockDriver(guard);
 
     if (res == CE_NO_ERROR)
     {
@@ -2553,11 +2614,11 @@ bool SBIGCCD::isExposureDone(INDI::CCDChip *targetChip)
 
     // Query command status:
     qcsp.command = CC_START_EXPOSURE2;
-    std::unique_lock<std::mutex> guard(sbigLock);
+    std::unique_lock<std::mutex> guard = lockDriver();
     int res = QueryCommandStatus(&qcsp, &qcsr);
     if (res != CE_NO_ERROR)
     {
-        guard.unlock();
+        unlockDriver(guard);
         return false;
     }
 
@@ -2572,13 +2633,13 @@ bool SBIGCCD::isExposureDone(INDI::CCDChip *targetChip)
     {
         // The exposure is still in progress, decrement an
         // exposure time:
-        guard.unlock();
+        unlockDriver(guard);
         return false;
     }
     // Exposure done - update client's property:
     eep.ccd = ccd;
     EndExposure(&eep);
-    guard.unlock();
+    unlockDriver(guard);
     return true;
 }
 
@@ -2607,13 +2668,21 @@ int SBIGCCD::readoutCCD(uint16_t left, uint16_t top, uint16_t width, uint16_t he
     srp.top         = top;
     srp.width       = width;
     srp.height      = height;
-    std::unique_lock<std::mutex> guard(sbigLock);
+    // The main chip is only read out by readoutThread, which leaves the lock
+    // to waiting commands between bands of lines. Only the built-in tracking
+    // CCD is interleaved with it, cameras with an external tracking head keep
+    // the driver locked for the whole readout as before.
+    bool banded = (targetChip == &PrimaryCCD && !m_useExternalTrackingCCD);
+    std::unique_lock<std::mutex> guard = banded ? std::unique_lock<std::mutex>(sbigLock) : lockDriver();
     res = StartReadout(&srp);
     if (res != CE_NO_ERROR)
     {
         LOGF_ERROR("%s readoutCCD - StartReadout error! (%s)",
                    (targetChip == &PrimaryCCD) ? "Primary" : "Guide", GetErrorString(res));
-        guard.unlock();
+        if (banded)
+            guard.unlock();
+        else
+            unlockDriver(guard);
         return res;
     }
     ReadoutLineParams rlp;
@@ -2623,21 +2692,142 @@ int SBIGCCD::readoutCCD(uint16_t left, uint16_t top, uint16_t width, uint16_t he
     rlp.pixelLength = width;
     for (h = 0; h < height; h++)
     {
+        if (banded && h > 0 && h % READOUT_BAND_LINES == 0)
+        {
+            driverIdle.wait(guard, [this]()
+            {
+                return driverPending == 0;
+            });
+            if (abortReadout)
+                break;
+        }
         ReadoutLine(&rlp, buffer + (h * width), false);
     }
     EndReadoutParams erp;
     erp.ccd = ccd;
-    if ((res = EndReadout(&erp)) != CE_NO_ERROR)
+    res = EndReadout(&erp);
+    if (banded)
+        guard.unlock();
+    else
+        unlockDriver(guard);
+    if (res != CE_NO_ERROR)
     {
         LOGF_ERROR("%s readoutCCD - EndReadout error! (%s)",
                    (targetChip == &PrimaryCCD) ? "Primary" : "Guide", GetErrorString(res));
-        guard.unlock();
-        return res;
     }
-    guard.unlock();
     return res;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Lock the universal driver for a command. A main chip readout in progress
+/// gives way to waiting commands at its next band of lines.
+/////////////////////////////////////////////////////////////////////////////
+std::unique_lock<std::mutex> SBIGCCD::lockDriver()
+{
+    driverPending++;
+    return std::unique_lock<std::mutex>(sbigLock);
+}
+
+void SBIGCCD::unlockDriver(std::unique_lock<std::mutex> &guard)
+{
+    // Decrement under the lock so that the readout thread cannot miss the notification
+    driverPending--;
+    guard.unlock();
+    driverIdle.notify_all();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Read out the main chip in the background
+/////////////////////////////////////////////////////////////////////////////
+void SBIGCCD::startMainReadout()
+{
+    abortReadout = false;
+    readoutFinished = false;
+    mainReadout = true;
+    readoutSinceGuideFrame = true;
+    readoutThread = std::thread([this]()
+    {
+        auto start = std::chrono::steady_clock::now();
+        readoutOK = readoutImage(&PrimaryCCD);
+        LOGF_DEBUG("Primary camera readout took %.f ms.",
+                   std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        readoutFinished = true;
+    });
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Complete the main chip frame on the main thread, like guide frames, and
+/// start the exposures requested during the readout
+/////////////////////////////////////////////////////////////////////////////
+void SBIGCCD::finishMainReadout()
+{
+    readoutThread.join();
+    mainReadout = false;
+
+    if (abortReadout)
+        LOG_DEBUG("Primary camera readout aborted");
+    else if (readoutOK == false)
+        PrimaryCCD.setExposureFailed();
+    else
+    {
+        LOG_DEBUG("Primary camera readout complete");
+        ExposureComplete(&PrimaryCCD);
+    }
+
+    if (pendingGuideExposure)
+    {
+        pendingGuideExposure = false;
+        if (StartGuideExposure(GuideExposureRequest) == false)
+            GuideCCD.setExposureFailed();
+    }
+
+    // Unless the fast exposure loop already started the next one
+    if (pendingExposure)
+    {
+        pendingExposure = false;
+        if (InExposure == false && StartExposure(ExposureRequest) == false)
+            PrimaryCCD.setExposureFailed();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Track the interval between guide frames and report how much main chip
+/// readouts disturbed it.
+/////////////////////////////////////////////////////////////////////////////
+void SBIGCCD::updateGuideCycle()
+{
+    auto now = std::chrono::steady_clock::now();
+    bool first = (m_LastGuideFrame.time_since_epoch().count() == 0);
+    double cycle = std::chrono::duration<double, std::milli>(now - m_LastGuideFrame).count();
+    bool duringReadout = mainReadout || readoutSinceGuideFrame;
+
+    m_LastGuideFrame = now;
+    readoutSinceGuideFrame = false;
+
+    // Guiding was restarted
+    if (first || cycle > GUIDE_RESTART_MS)
+        return;
+
+    if (duringReadout)
+    {
+        m_ReadoutGuideFrames++;
+        m_ReadoutGuideCycleMax = std::max(m_ReadoutGuideCycleMax, cycle);
+        if (m_GuideCycle > 0)
+            m_ReadoutGuideJitter = std::max(m_ReadoutGuideJitter, fabs(cycle - m_GuideCycle));
+        return;
+    }
+
+    if (m_ReadoutGuideFrames > 0)
+    {
+        LOGF_DEBUG("Guide cycle during primary camera readout: %d frames, up to %.f ms, jitter %.f ms (usual cycle %.f ms).",
+                   m_ReadoutGuideFrames, m_ReadoutGuideCycleMax, m_ReadoutGuideJitter, m_GuideCycle);
+        m_ReadoutGuideFrames = 0;
+        m_ReadoutGuideCycleMax = m_ReadoutGuideJitter = 0;
+    }
+
+    m_GuideCycle = (m_GuideCycle > 0) ? 0.9 * m_GuideCycle + 0.1 * cycle : cycle;
+}
+
 //==========================================================================
 
 int SBIGCCD::CFWConnect()
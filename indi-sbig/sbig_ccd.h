@@ -37,7 +37,10 @@
 #include <sbigudrv.h>
 #endif
 
+#include <atomic>
+#include <condition_variable>
 #include <string>
+#include <thread>
 
 #define DEVICE struct usb_device *
 
@@ -271,7 +274,34 @@ class SBIGCCD : public INDI::CCD, public INDI::FilterInterface
         /////////////////////////////////////////////////////////////////////////////
         /// Threading Variables
         /////////////////////////////////////////////////////////////////////////////
+        // Serializes all universal driver calls. The main chip is read out by
+        // readoutThread in bands of lines, and commands waiting in lockDriver,
+        // such as guide chip exposures and readouts, are run between bands.
         std::mutex sbigLock;
+        std::condition_variable driverIdle;
+        std::atomic<int> driverPending { 0 };
+        std::thread readoutThread;
+        // Set from the start of a main chip readout until TimerHit has completed it
+        std::atomic<bool> mainReadout { false };
+        std::atomic<bool> abortReadout { false };
+        // Set by readoutThread once the frame is read, with the result in readoutOK
+        std::atomic<bool> readoutFinished { false };
+        bool readoutOK { false };
+        // Exposures requested during a main chip readout, started once it is completed
+        bool pendingExposure { false };
+        bool pendingGuideExposure { false };
+        // A main chip readout ran since the last guide frame
+        std::atomic<bool> readoutSinceGuideFrame { false };
+
+        /////////////////////////////////////////////////////////////////////////////
+        /// Guide cycle statistics, to report the jitter caused by main chip readouts
+        /////////////////////////////////////////////////////////////////////////////
+        std::chrono::steady_clock::time_point m_LastGuideFrame;
+        // Smoothed interval between guide frames outside main chip readouts, ms
+        double m_GuideCycle { 0 };
+        // Guide frames, longest interval and largest deviation during main chip readouts
+        int m_ReadoutGuideFrames { 0 };
+        double m_ReadoutGuideCycleMax { 0 }, m_ReadoutGuideJitter { 0 };
 
         /////////////////////////////////////////////////////////////////////////////
         /// Exposure Variables
@@ -404,6 +434,11 @@ class SBIGCCD : public INDI::CCD, public INDI::FilterInterface
         int getShutterMode(INDI::CCDChip *targetChip, int &shutter);
         int readoutCCD(unsigned short left, unsigned short top, unsigned short width, unsigned short height,
                        unsigned short *buffer, INDI::CCDChip *targetChip);
+        std::unique_lock<std::mutex> lockDriver();
+        void unlockDriver(std::unique_lock<std::mutex> &guard);
+        void startMainReadout();
+        void finishMainReadout();
+        void updateGuideCycle();
 
         /////////////////////////////////////////////////////////////////////////////
         /// Filter Wheel Functions
@@ -429,6 +464,7 @@ class SBIGCCD : public INDI::CCD, public INDI::FilterInterface
         /// Utility Functions
         /////////////////////////////////////////////////////////////////////////////
         bool grabImage(INDI::CCDChip *targetChip);
+        bool readoutImage(INDI::CCDChip *targetChip);
         bool setupParams();
         // SBIG's software interface to the Universal Driver Library function:
         int SBIGUnivDrvCommand(PAR_COMMAND, void *, void *);
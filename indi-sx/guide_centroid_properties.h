@@ -0,0 +1,233 @@
+/*
+    Properties of the centroid only guide mode
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include "guide_centroid.h"
+
+#include <defaultdevice.h>
+#include <indiccd.h>
+#include <indipropertynumber.h>
+#include <indipropertyswitch.h>
+
+#include <cstdio>
+#include <string>
+
+namespace GuideCentroid
+{
+
+/**
+ * Switches, settings and star measurement of the centroid only mode of one chip.
+ *
+ * In centroid only mode the driver publishes the star position measured in the
+ * tracking box instead of the frame, and sends a full frame only on request or
+ * every FRAME_INTERVAL frames.
+ */
+class Properties
+{
+    public:
+        enum
+        {
+            BOX_X,
+            BOX_Y,
+            BOX_SIZE,
+            FRAME_INTERVAL
+        };
+
+        enum
+        {
+            STAR_X,
+            STAR_Y,
+            STAR_FLUX,
+            STAR_SNR
+        };
+
+        /**
+         * @brief init Fill the properties.
+         * @param prefix of the property names, e.g. "CCD_GUIDE" for the primary chip and "GUIDER" for a guide head
+         */
+        void init(const char *deviceName, const char *prefix, const char *group)
+        {
+            std::string name(prefix);
+
+            CentroidSP[0].fill("CENTROID_OFF", "Off", ISS_ON);
+            CentroidSP[1].fill("CENTROID_ON",  "On",  ISS_OFF);
+            CentroidSP.fill(deviceName, (name + "_CENTROID").c_str(), "Centroid Only", group, IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+
+            FrameSP[0].fill("SEND_FRAME", "Send next frame", ISS_OFF);
+            FrameSP.fill(deviceName, (name + "_CENTROID_FRAME").c_str(), "Full Frame", group, IP_RW, ISR_ATMOST1, 60, IPS_IDLE);
+
+            SettingsNP[BOX_X         ].fill("BOX_X",          "Box X",               "%.f", 0, 16000, 1, 0);
+            SettingsNP[BOX_Y         ].fill("BOX_Y",          "Box Y",               "%.f", 0, 16000, 1, 0);
+            SettingsNP[BOX_SIZE      ].fill("BOX_SIZE",       "Box size",            "%.f", 0,  1024, 1, 32);
+            SettingsNP[FRAME_INTERVAL].fill("FRAME_INTERVAL", "Send every N frames", "%.f", 0,  1000, 1, 0);
+            SettingsNP.fill(deviceName, (name + "_CENTROID_SETTINGS").c_str(), "Settings", group, IP_RW, 60, IPS_IDLE);
+
+            StarNP[STAR_X   ].fill("STAR_X",    "X",    "%.3f", 0, 16000, 0, 0);
+            StarNP[STAR_Y   ].fill("STAR_Y",    "Y",    "%.3f", 0, 16000, 0, 0);
+            StarNP[STAR_FLUX].fill("STAR_FLUX", "Flux", "%.f",  0, 1e12,  0, 0);
+            StarNP[STAR_SNR ].fill("STAR_SNR",  "SNR",  "%.2f", 0, 1e6,   0, 0);
+            StarNP.fill(deviceName, (name + "_STAR").c_str(), "Guide Star", group, IP_RO, 60, IPS_IDLE);
+        }
+
+        void define(INDI::DefaultDevice *device)
+        {
+            device->defineProperty(CentroidSP);
+            device->defineProperty(FrameSP);
+            device->defineProperty(SettingsNP);
+            device->defineProperty(StarNP);
+        }
+
+        void remove(INDI::DefaultDevice *device)
+        {
+            device->deleteProperty(CentroidSP.getName());
+            device->deleteProperty(FrameSP.getName());
+            device->deleteProperty(SettingsNP.getName());
+            device->deleteProperty(StarNP.getName());
+        }
+
+        bool isEnabled()
+        {
+            return CentroidSP[1].getState() == ISS_ON;
+        }
+
+        /** Handle a new switch vector, false if it is not one of these properties */
+        bool processSwitch(const char *name, ISState *states, char *names[], int n)
+        {
+            if (CentroidSP.isNameMatch(name))
+            {
+                if (!CentroidSP.update(states, names, n))
+                {
+                    CentroidSP.setState(IPS_ALERT);
+                    CentroidSP.apply();
+                    return true;
+                }
+
+                frames = 0;
+                CentroidSP.setState(isEnabled() ? IPS_BUSY : IPS_IDLE);
+                CentroidSP.apply();
+                return true;
+            }
+
+            if (FrameSP.isNameMatch(name))
+            {
+                FrameSP.update(states, names, n);
+                FrameSP.setState(FrameSP[0].getState() == ISS_ON ? IPS_BUSY : IPS_IDLE);
+                FrameSP.apply();
+                return true;
+            }
+
+            return false;
+        }
+
+        /** Handle a new number vector, false if it is not one of these properties */
+        bool processNumber(const char *name, double values[], char *names[], int n)
+        {
+            if (SettingsNP.isNameMatch(name))
+            {
+                SettingsNP.setState(SettingsNP.update(values, names, n) ? IPS_OK : IPS_ALERT);
+                SettingsNP.apply();
+                return true;
+            }
+
+            return false;
+        }
+
+        void save(FILE *fp)
+        {
+            SettingsNP.save(fp);
+        }
+
+        /** Measure and publish the guide star, return true if the full frame should be sent as well */
+        bool update(const Frame &frame)
+        {
+            uint32_t boxSize = static_cast<uint32_t>(SettingsNP[BOX_SIZE].getValue());
+            Result star = compute(frame,
+                                  static_cast<uint32_t>(SettingsNP[BOX_X].getValue()),
+                                  static_cast<uint32_t>(SettingsNP[BOX_Y].getValue()),
+                                  boxSize);
+
+            if (star.valid)
+            {
+                StarNP[STAR_X   ].setValue(star.x);
+                StarNP[STAR_Y   ].setValue(star.y);
+                StarNP[STAR_FLUX].setValue(star.flux);
+                StarNP[STAR_SNR ].setValue(star.snr);
+                StarNP.setState(IPS_OK);
+
+                // Keep the tracking box centered on the star
+                if (boxSize > 0)
+                {
+                    SettingsNP[BOX_X].setValue(std::max(0.0, std::round(star.x - boxSize / 2.0)));
+                    SettingsNP[BOX_Y].setValue(std::max(0.0, std::round(star.y - boxSize / 2.0)));
+                    SettingsNP.apply();
+                }
+            }
+            else
+            {
+                StarNP[STAR_SNR].setValue(0);
+                StarNP.setState(IPS_ALERT);
+            }
+            StarNP.apply();
+
+            uint32_t interval = static_cast<uint32_t>(SettingsNP[FRAME_INTERVAL].getValue());
+            bool sendFrame = (FrameSP[0].getState() == ISS_ON) || (interval > 0 && ++frames >= interval);
+
+            if (sendFrame)
+            {
+                frames = 0;
+                if (FrameSP[0].getState() == ISS_ON)
+                {
+                    FrameSP[0].setState(ISS_OFF);
+                    FrameSP.setState(IPS_OK);
+                    FrameSP.apply();
+                }
+            }
+
+            return sendFrame;
+        }
+
+    private:
+        INDI::PropertySwitch CentroidSP {2};
+        INDI::PropertySwitch FrameSP {1};
+        INDI::PropertyNumber SettingsNP {4};
+        INDI::PropertyNumber StarNP {4};
+
+        // Frames since the last full frame was sent
+        uint32_t frames {0};
+};
+
+/**
+ * Finish an exposure whose frame is not sent. The exposure property of the
+ * chip turns OK without the frame being encoded, uploaded or saved, so the
+ * upload settings of INDI::CCD are left alone.
+ * @param exposureName name of the exposure property of the chip, e.g. "CCD_EXPOSURE" or "GUIDER_EXPOSURE"
+ */
+inline void completeExposure(INDI::DefaultDevice *device, INDI::CCDChip *chip, const char *exposureName)
+{
+    chip->setExposureLeft(0);
+
+    INumberVectorProperty *exposureNP = device->getNumber(exposureName);
+    if (exposureNP != nullptr)
+    {
+        exposureNP->s = IPS_OK;
+        IDSetNumber(exposureNP, nullptr);
+    }
+}
+
+}
@@ -34,6 +34,9 @@
 #include <string.h>
 #include <connectionplugins/connectionserial.h>
 
+#define SXAO_POLL_MS         10    /* Period of publishing command results while the queue is busy */
+#define SXAO_CENTER_TIMEOUT  10000 /* ms, centering and unjamming move the mirror over its full range */
+
 static std::unique_ptr<SXAO> sxao(new SXAO);
 
 void ISGetProperties(const char *dev)
@@ -83,38 +86,24 @@ const char *SXAO::getDefaultName()
     return "SX AO";
 }
 
-int SXAO::aoCommand(const char *request, char *response, int nbytes)
+int SXAO::aoCommand(const char *request, char *response, int nbytes, double extraTimeout)
 {
-    if (isSimulation())
-    {
-        LOGF_DEBUG("simulation: command %s", request);
-
-        if (!strcmp(request, "X"))
-            strcpy(response, "Y");
-        else
-            strcpy(response, "*");
-        return TTY_OK;
-    }
-
-    int actual;
-    int rc = tty_write(PortFD, request, strlen(request), &actual);
-
     LOGF_DEBUG("CMD <%s>", request);
 
-    if (rc == TTY_OK)
+    if (!queue.transact(request, response, nbytes, extraTimeout))
     {
-        rc = tty_read(PortFD, response, nbytes, 10, &actual);
-        response[actual] = 0;
-        LOGF_DEBUG("RES <%s>", response);
-    }
-    else
-    {
-        char errstr[MAXRBUF];
-        tty_error_msg(rc, errstr, MAXRBUF);
-        LOGF_ERROR("aoCommand TTY error: %s", errstr);
+        LOGF_ERROR("aoCommand <%s> timed out.", request);
+        return TTY_TIME_OUT;
     }
 
-    return rc;
+    LOGF_DEBUG("RES <%s>", response);
+    return TTY_OK;
+}
+
+void SXAO::schedulePoll()
+{
+    if (pollTimerID < 0)
+        pollTimerID = SetTimer(SXAO_POLL_MS);
 }
 
 bool SXAO::initProperties()
@@ -161,6 +150,12 @@ bool SXAO::Handshake()
 {
     PortFD = serialConnection->getPortFD();
 
+    if (!queue.start(PortFD, isSimulation()))
+    {
+        LOG_ERROR("Failed to start the command queue.");
+        return false;
+    }
+
     char buf[8] = {0};
     int rc = aoCommand("X", buf, 1);
 
@@ -172,6 +167,7 @@ bool SXAO::Handshake()
             if (!strcmp(FWT[0].text, "V000"))
             {
                 LOG_ERROR("Firmware needs to be updated!");
+                queue.stop();
                 return false;
             }
             AOCenter();
@@ -180,13 +176,30 @@ bool SXAO::Handshake()
         else
         {
             LOG_ERROR("Not SXAO was detected.");
-            return false;
         }
     }
 
+    queue.stop();
     return false;
 }
 
+bool SXAO::Disconnect()
+{
+    if (pollTimerID >= 0)
+    {
+        RemoveTimer(pollTimerID);
+        pollTimerID = -1;
+    }
+
+    SXAOQueue::Statistics stats = queue.getStatistics();
+    LOGF_DEBUG("%u commands sent, %u corrections merged, %u timeouts, max latency %.1f ms.", stats.sent, stats.merged,
+               stats.timeouts, stats.maxLatency);
+    queue.stop();
+    limitPending = false;
+
+    return DefaultDevice::Disconnect();
+}
+
 bool SXAO::updateProperties()
 {
     INDI::DefaultDevice::updateProperties();
@@ -218,40 +231,36 @@ bool SXAO::ISNewNumber(const char *dev, const char *name, double values[], char
 {
     if (strcmp(name, AONSNP.name) == 0)
     {
-        AONSNP.s = IPS_BUSY;
         IUUpdateNumber(&AONSNP, values, names, n);
-        IDSetNumber(&AONSNP, nullptr);
+        AONSNP.s = IPS_OK;
         if (AONS[0].value != 0)
         {
-            AONSNP.s      = AONorth(AONS[0].value) ? IPS_OK : IPS_ALERT;
+            AONSNP.s      = AONorth(AONS[0].value) ? IPS_BUSY : IPS_ALERT;
             AONS[0].value = 0;
         }
         else if (AONS[1].value != 0)
         {
-            AONSNP.s      = AOSouth(AONS[1].value) ? IPS_OK : IPS_ALERT;
+            AONSNP.s      = AOSouth(AONS[1].value) ? IPS_BUSY : IPS_ALERT;
             AONS[1].value = 0;
         }
         IDSetNumber(&AONSNP, nullptr);
-        CheckLimit(false);
         return true;
     }
     else if (strcmp(name, AOWENP.name) == 0)
     {
-        AOWENP.s = IPS_BUSY;
         IUUpdateNumber(&AOWENP, values, names, n);
-        IDSetNumber(&AOWENP, nullptr);
+        AOWENP.s = IPS_OK;
         if (AOWE[0].value != 0)
         {
-            AOWENP.s      = AOEast(AOWE[0].value) ? IPS_OK : IPS_ALERT;
+            AOWENP.s      = AOEast(AOWE[0].value) ? IPS_BUSY : IPS_ALERT;
             AOWE[0].value = 0;
         }
         else if (AOWE[1].value != 0)
         {
-            AOWENP.s      = AOWest(AOWE[1].value) ? IPS_OK : IPS_ALERT;
+            AOWENP.s      = AOWest(AOWE[1].value) ? IPS_BUSY : IPS_ALERT;
             AOWE[1].value = 0;
         }
         IDSetNumber(&AOWENP, nullptr);
-        CheckLimit(false);
         return true;
     }
     else if (!strcmp(name, GuideNSNP.name) || !strcmp(name, GuideWENP.name))
@@ -291,102 +300,163 @@ bool SXAO::ISNewSwitch(const char *dev, const char *name, ISState *states, char
 
 IPState SXAO::GuideNorth(uint32_t ms)
 {
-    char buf[8];
-    sprintf(buf, "MN%05d", (uint16_t)(ms / 10));
-    int rc = aoCommand(buf, buf, 1);
-    return (rc == TTY_OK ? IPS_OK : IPS_ALERT);
+    if (!queue.isRunning())
+        return IPS_ALERT;
+    queue.correction('M', 'N', ms / 10, TAG_GUIDE_NS);
+    schedulePoll();
+    return IPS_BUSY;
 }
 
 IPState SXAO::GuideSouth(uint32_t ms)
 {
-    char buf[8];
-    sprintf(buf, "MS%05d", (uint16_t)(ms / 10));
-    int rc = aoCommand(buf, buf, 1);
-    return (rc == TTY_OK ? IPS_OK : IPS_ALERT);
+    if (!queue.isRunning())
+        return IPS_ALERT;
+    queue.correction('M', 'S', ms / 10, TAG_GUIDE_NS);
+    schedulePoll();
+    return IPS_BUSY;
 }
 
 IPState SXAO::GuideEast(uint32_t ms)
 {
-    char buf[8];
-    sprintf(buf, "MT%05d", (uint16_t)(ms / 10));
-    int rc = aoCommand(buf, buf, 1);
-    return (rc == TTY_OK ? IPS_OK : IPS_ALERT);
+    if (!queue.isRunning())
+        return IPS_ALERT;
+    queue.correction('M', 'T', ms / 10, TAG_GUIDE_WE);
+    schedulePoll();
+    return IPS_BUSY;
 }
 
 IPState SXAO::GuideWest(uint32_t ms)
 {
-    char buf[8];
-    sprintf(buf, "MW%05d", (uint16_t)(ms / 10));
-    int rc = aoCommand(buf, buf, 1);
-    return (rc == TTY_OK ? IPS_OK : IPS_ALERT);
+    if (!queue.isRunning())
+        return IPS_ALERT;
+    queue.correction('M', 'W', ms / 10, TAG_GUIDE_WE);
+    schedulePoll();
+    return IPS_BUSY;
 }
 
 bool SXAO::AONorth(int steps)
 {
-    char buf[8];
-    sprintf(buf, "GN%05d", steps);
-    int rc = aoCommand(buf, buf, 1);
-    rc     = rc == TTY_OK && !strcmp(buf, "G");
-    return rc;
+    if (!queue.isRunning())
+        return false;
+    queue.correction('G', 'N', steps, TAG_TILT_NS);
+    schedulePoll();
+    return true;
 }
 
 bool SXAO::AOSouth(int steps)
 {
-    char buf[8];
-    sprintf(buf, "GS%05d", steps);
-    int rc = aoCommand(buf, buf, 1);
-    rc     = rc == TTY_OK && !strcmp(buf, "G");
-    return rc;
+    if (!queue.isRunning())
+        return false;
+    queue.correction('G', 'S', steps, TAG_TILT_NS);
+    schedulePoll();
+    return true;
 }
 
 bool SXAO::AOEast(int steps)
 {
-    char buf[8];
-    sprintf(buf, "GT%05d", steps);
-    int rc = aoCommand(buf, buf, 1);
-    rc     = rc == TTY_OK && !strcmp(buf, "G");
-    return rc;
+    if (!queue.isRunning())
+        return false;
+    queue.correction('G', 'T', steps, TAG_TILT_WE);
+    schedulePoll();
+    return true;
 }
 
 bool SXAO::AOWest(int steps)
 {
-    char buf[8];
-    sprintf(buf, "GW%05d", steps);
-    int rc = aoCommand(buf, buf, 1);
-    rc     = rc == TTY_OK && !strcmp(buf, "G");
-    return rc;
+    if (!queue.isRunning())
+        return false;
+    queue.correction('G', 'W', steps, TAG_TILT_WE);
+    schedulePoll();
+    return true;
 }
 
 bool SXAO::AOCenter()
 {
     char buf[8];
-    int rc = aoCommand("K", buf, 1);
+    int rc = aoCommand("K", buf, 1, SXAO_CENTER_TIMEOUT);
     return rc == TTY_OK;
 }
 
 bool SXAO::AOUnjam()
 {
     char buf[8];
-    int rc = aoCommand("R", buf, 1);
+    int rc = aoCommand("R", buf, 1, SXAO_CENTER_TIMEOUT);
     return rc == TTY_OK;
 }
 
 void SXAO::CheckLimit(bool force)
 {
-    char buf[8];
-    int rc = aoCommand("L", buf, 1);
-    if (rc == TTY_OK)
+    limitForced |= force;
+
+    // One limit check in flight answers for all the tilts before it
+    if (limitPending || !queue.isRunning())
+        return;
+    limitPending = true;
+    queue.command("L", 1, TAG_LIMIT);
+    schedulePoll();
+}
+
+void SXAO::updateLimit(char limit, bool force)
+{
+    if (force || limit != lastLimit)
+    {
+        AtLimitL[0].s = (limit & 0x01) == 0x01 ? IPS_ALERT : IPS_IDLE;
+        AtLimitL[1].s = (limit & 0x04) == 0x04 ? IPS_ALERT : IPS_IDLE;
+        AtLimitL[2].s = (limit & 0x02) == 0x02 ? IPS_ALERT : IPS_IDLE;
+        AtLimitL[3].s = (limit & 0x08) == 0x08 ? IPS_ALERT : IPS_IDLE;
+        AtLimitLP.s   = (limit & 0x0F) ? IPS_ALERT : IPS_IDLE;
+        IDSetLight(&AtLimitLP, nullptr);
+        lastLimit = limit;
+    }
+}
+
+void SXAO::TimerHit()
+{
+    pollTimerID = -1;
+
+    bool tilted = false;
+    SXAOQueue::Result result;
+    while (queue.takeResult(result))
     {
-        char limit = buf[0];
-        if (force || limit != lastLimit)
+        LOGF_DEBUG("CMD <%s> RES <%s> in %.1f ms, %u corrections merged", result.request.c_str(), result.response.c_str(),
+                   result.latency, result.merged);
+
+        switch (result.tag)
         {
-            AtLimitL[0].s = (limit & 0x01) == 0x01 ? IPS_ALERT : IPS_IDLE;
-            AtLimitL[1].s = (limit & 0x04) == 0x04 ? IPS_ALERT : IPS_IDLE;
-            AtLimitL[2].s = (limit & 0x02) == 0x02 ? IPS_ALERT : IPS_IDLE;
-            AtLimitL[3].s = (limit & 0x08) == 0x08 ? IPS_ALERT : IPS_IDLE;
-            AtLimitLP.s   = (limit & 0x0F) ? IPS_ALERT : IPS_IDLE;
-            IDSetLight(&AtLimitLP, nullptr);
-            lastLimit = limit;
+            case TAG_TILT_NS:
+            case TAG_TILT_WE:
+            {
+                INumberVectorProperty *tiltNP = result.tag == TAG_TILT_NS ? &AONSNP : &AOWENP;
+                tiltNP->s = (result.ok && result.response == "G") ? IPS_OK : IPS_ALERT;
+                IDSetNumber(tiltNP, nullptr);
+                tilted = true;
+                break;
+            }
+
+            case TAG_GUIDE_NS:
+            case TAG_GUIDE_WE:
+                if (result.ok)
+                    GuideComplete(result.tag == TAG_GUIDE_NS ? AXIS_DE : AXIS_RA);
+                else
+                {
+                    INumberVectorProperty *guideNP = result.tag == TAG_GUIDE_NS ? &GuideNSNP : &GuideWENP;
+                    guideNP->s = IPS_ALERT;
+                    IDSetNumber(guideNP, nullptr);
+                }
+                break;
+
+            case TAG_LIMIT:
+                limitPending = false;
+                if (result.ok)
+                    updateLimit(result.response[0], limitForced);
+                limitForced = false;
+                break;
         }
     }
+
+    if (tilted)
+        CheckLimit(false);
+
+    if (!queue.idle())
+        schedulePoll();
 }
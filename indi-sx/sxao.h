@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include "sxaoqueue.h"
+
 #include <defaultdevice.h>
 #include <indiguiderinterface.h>
 
@@ -40,6 +42,8 @@ class SXAO : public INDI::DefaultDevice, INDI::GuiderInterface
 
         bool initProperties();
         bool updateProperties();
+        bool Disconnect() override;
+        void TimerHit() override;
 
         IPState GuideNorth(uint32_t ms);
         IPState GuideSouth(uint32_t ms);
@@ -59,8 +63,20 @@ class SXAO : public INDI::DefaultDevice, INDI::GuiderInterface
         const char *getDefaultName();
 
     private:
-        int aoCommand(const char *request, char *response, int nbytes);
+        // Tags of the queued commands whose results are handled in TimerHit
+        enum
+        {
+            TAG_TILT_NS,
+            TAG_TILT_WE,
+            TAG_GUIDE_NS,
+            TAG_GUIDE_WE,
+            TAG_LIMIT
+        };
+
+        int aoCommand(const char *request, char *response, int nbytes, double extraTimeout = 0);
         bool Handshake();
+        void schedulePoll();
+        void updateLimit(char limit, bool force);
 
         INumber AONS[2];
         INumberVectorProperty AONSNP;
@@ -78,6 +94,13 @@ class SXAO : public INDI::DefaultDevice, INDI::GuiderInterface
         ILightVectorProperty AtLimitLP;
 
         char lastLimit = -1;
+        // Limit check queued, and whether its result is published even if unchanged
+        bool limitPending { false };
+        bool limitForced { false };
+
+        // Corrections are written and answered on the queue worker, results are published from TimerHit
+        SXAOQueue queue;
+        int pollTimerID { -1 };
 
         Connection::Serial *serialConnection { nullptr };
 
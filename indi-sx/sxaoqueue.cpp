@@ -0,0 +1,449 @@
+/*
+ Starlight Xpress Active Optics command queue
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option)
+ any later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ The full GNU General Public License is included in this distribution in the
+ file called LICENSE.
+ */
+
+#include "sxaoqueue.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SXAO_INITIAL_TIMEOUT 1000.0 // ms, until the first reply of a command kind is measured
+#define SXAO_MIN_TIMEOUT     250.0  // ms
+#define SXAO_MAX_TIMEOUT     2000.0 // ms
+#define SXAO_MAX_AMOUNT      99999  // largest amount of a correction command, larger ones are sent in parts
+#define SXAO_STEP_TIMEOUT    5.0    // ms allowed per tilt step, as merged corrections vary in size
+
+static double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+SXAOQueue::SXAOQueue()
+{
+}
+
+SXAOQueue::~SXAOQueue()
+{
+    stop();
+}
+
+bool SXAOQueue::start(int value, bool simulate)
+{
+    stop();
+
+    if (pipe(wakeup) < 0)
+        return false;
+    fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakeup[1], F_SETFL, O_NONBLOCK);
+
+    fd         = value;
+    simulation = simulate;
+    pending.clear();
+    inFlight.clear();
+    results.clear();
+    waitedResults.clear();
+    estimators.clear();
+    resync     = Clock::time_point();
+    stats      = Statistics();
+    running    = true;
+    worker     = std::thread(&SXAOQueue::run, this);
+    return true;
+}
+
+void SXAOQueue::stop()
+{
+    if (!worker.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        running = false;
+    }
+    if (write(wakeup[1], "", 1) < 0)
+    {
+        // The pipe is full, so the worker is about to wake up anyway
+    }
+    worker.join();
+
+    {
+        // Release the callers of transact()
+        std::lock_guard<std::mutex> guard(lock);
+        for (auto &entry : pending)
+            complete(entry, std::string(), false);
+        for (auto &entry : inFlight)
+            complete(entry, std::string(), false);
+        pending.clear();
+        inFlight.clear();
+    }
+
+    close(wakeup[0]);
+    close(wakeup[1]);
+    wakeup[0] = wakeup[1] = -1;
+}
+
+void SXAOQueue::setDepth(int value)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    depth = static_cast<size_t>(std::max(value, 1));
+}
+
+void SXAOQueue::enqueue(Entry &entry)
+{
+    entry.id     = nextID++;
+    entry.queued = Clock::now();
+    stats.queued++;
+    pending.push_back(entry);
+    if (write(wakeup[1], "", 1) < 0)
+    {
+        // The pipe is full, so the worker is about to wake up anyway
+    }
+}
+
+void SXAOQueue::correction(char kind, char direction, int amount, int tag)
+{
+    char axis        = (direction == 'N' || direction == 'S') ? 'N' : 'T';
+    int signedAmount = (direction == 'N' || direction == 'T') ? amount : -amount;
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (!running)
+        return;
+
+    // A correction not sent yet is superseded by the sum of both
+    for (auto &entry : pending)
+    {
+        if (entry.kind == kind && entry.axis == axis && entry.tag == tag)
+        {
+            entry.amount += signedAmount;
+            entry.merged++;
+            stats.merged++;
+            stats.queued++;
+            return;
+        }
+    }
+
+    Entry entry;
+    entry.tag    = tag;
+    entry.kind   = kind;
+    entry.axis   = axis;
+    entry.amount = signedAmount;
+    entry.length = 1;
+    enqueue(entry);
+}
+
+void SXAOQueue::command(const char *request, size_t length, int tag, double extra)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!running)
+        return;
+
+    Entry entry;
+    entry.tag     = tag;
+    entry.request = request;
+    entry.length  = length;
+    entry.extra   = extra;
+    enqueue(entry);
+}
+
+bool SXAOQueue::transact(const char *request, char *reply, size_t length, double extra)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    if (!running)
+        return false;
+
+    Entry entry;
+    entry.request = request;
+    entry.length  = length;
+    entry.extra   = extra;
+    entry.waited  = true;
+    enqueue(entry);
+
+    uint64_t id = entry.id;
+    replied.wait(guard, [&]()
+    {
+        return waitedResults.count(id) > 0;
+    });
+
+    Result result = waitedResults[id];
+    waitedResults.erase(id);
+
+    size_t n = std::min(result.response.size(), length);
+    memcpy(reply, result.response.data(), n);
+    reply[n] = 0;
+    return result.ok;
+}
+
+bool SXAOQueue::takeResult(Result &result)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (results.empty())
+        return false;
+    result = results.front();
+    results.pop_front();
+    return true;
+}
+
+bool SXAOQueue::idle()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return pending.empty() && !writing && inFlight.empty() && results.empty();
+}
+
+SXAOQueue::Statistics SXAOQueue::getStatistics()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
+
+double SXAOQueue::timeoutOf(const Entry &entry)
+{
+    double timeout = SXAO_INITIAL_TIMEOUT;
+    auto estimator = estimators.find(entry.request[0]);
+    if (estimator != estimators.end())
+        timeout = std::min(std::max(estimator->second.srtt + 4 * estimator->second.rttVar, SXAO_MIN_TIMEOUT), SXAO_MAX_TIMEOUT);
+
+    // Tilts take longer with the number of steps, and mount guide pulses may be answered once the pulse is over
+    if (entry.kind == 'G')
+        timeout += std::abs(entry.amount) * SXAO_STEP_TIMEOUT;
+    else if (entry.kind == 'M')
+        timeout += std::abs(entry.amount) * 10.0;
+
+    return timeout + entry.extra;
+}
+
+std::string SXAOQueue::simulatedReply(const Entry &entry) const
+{
+    if (entry.request == "X")
+        return "Y";
+    return std::string(entry.length, '*');
+}
+
+void SXAOQueue::complete(Entry &entry, const std::string &response, bool ok)
+{
+    // Parts of a correction are reported with its last part
+    if (entry.partial)
+    {
+        if (ok)
+            stats.completed++;
+        else
+        {
+            for (auto &rest : pending)
+                if (rest.kind == entry.kind && rest.axis == entry.axis && rest.tag == entry.tag)
+                    rest.failed = true;
+        }
+        return;
+    }
+    ok = ok && !entry.failed;
+
+    Clock::time_point now = Clock::now();
+
+    Result result;
+    result.tag      = entry.tag;
+    result.request  = entry.request;
+    result.response = response;
+    result.ok       = ok;
+    result.merged   = entry.merged;
+    result.latency  = elapsedMs(entry.queued, now);
+
+    if (ok)
+    {
+        stats.completed++;
+        stats.lastLatency = result.latency;
+        stats.maxLatency  = std::max(stats.maxLatency, result.latency);
+    }
+
+    if (entry.waited)
+    {
+        waitedResults[entry.id] = result;
+        replied.notify_all();
+    }
+    else
+        results.push_back(result);
+}
+
+bool SXAOQueue::writeEntry(Entry &entry)
+{
+    const char *data = entry.request.data();
+    size_t left      = entry.request.size();
+
+    while (left > 0)
+    {
+        ssize_t n = write(fd, data, left);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN)
+            {
+                struct pollfd pfd = { fd, POLLOUT, 0 };
+                poll(&pfd, 1, 100);
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        left -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void SXAOQueue::run()
+{
+    std::string input;
+    char buffer[64];
+
+    std::unique_lock<std::mutex> guard(lock);
+    while (running)
+    {
+        // Write as many commands as the depth allows
+        while (inFlight.size() < depth && !pending.empty() && Clock::now() >= resync)
+        {
+            Entry entry = pending.front();
+
+            // A correction too large for one command is sent in parts, the rest stays queued
+            if (entry.kind != 0 && std::abs(entry.amount) > SXAO_MAX_AMOUNT)
+            {
+                entry.amount  = entry.amount > 0 ? SXAO_MAX_AMOUNT : -SXAO_MAX_AMOUNT;
+                entry.merged  = 0;
+                entry.partial = true;
+                pending.front().amount -= entry.amount;
+            }
+            else
+                pending.pop_front();
+
+            if (entry.kind != 0)
+            {
+                int amount = std::abs(entry.amount);
+                char direction = entry.axis == 'N' ? (entry.amount >= 0 ? 'N' : 'S') : (entry.amount >= 0 ? 'T' : 'W');
+                snprintf(buffer, sizeof(buffer), "%c%c%05d", entry.kind, direction, amount);
+                entry.request = buffer;
+
+                // Corrections which cancel each other out need not be sent
+                if (amount == 0)
+                {
+                    complete(entry, std::string(1, entry.kind), true);
+                    continue;
+                }
+            }
+
+            if (simulation)
+            {
+                stats.sent++;
+                complete(entry, simulatedReply(entry), true);
+                continue;
+            }
+
+            writing = true;
+            guard.unlock();
+            bool written = writeEntry(entry);
+            guard.lock();
+            writing = false;
+
+            entry.sent     = Clock::now();
+            entry.deadline = entry.sent + std::chrono::microseconds(static_cast<int64_t>(timeoutOf(entry) * 1000));
+            if (!written)
+            {
+                complete(entry, std::string(), false);
+                continue;
+            }
+            stats.sent++;
+            inFlight.push_back(entry);
+        }
+
+        int wait = -1;
+        if (!inFlight.empty())
+            wait = static_cast<int>(std::max(0.0, std::ceil(elapsedMs(Clock::now(), inFlight.front().deadline))));
+        else if (!pending.empty())
+            wait = static_cast<int>(std::max(0.0, std::ceil(elapsedMs(Clock::now(), resync))));
+        guard.unlock();
+
+        struct pollfd pfd[2] = { { wakeup[0], POLLIN, 0 }, { simulation ? -1 : fd, POLLIN, 0 } };
+        int rc = poll(pfd, 2, wait);
+        if (rc > 0 && (pfd[0].revents & POLLIN))
+        {
+            while (read(wakeup[0], buffer, sizeof(buffer)) > 0)
+                ;
+        }
+        if (rc > 0 && (pfd[1].revents & POLLIN))
+        {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n > 0)
+                input.append(buffer, static_cast<size_t>(n));
+        }
+
+        guard.lock();
+        Clock::time_point now = Clock::now();
+
+        // Replies come in the order of the commands
+        while (!inFlight.empty() && input.size() >= inFlight.front().length)
+        {
+            Entry &entry = inFlight.front();
+
+            // With several commands in flight, the reply could not start before the previous one
+            Clock::time_point start = std::max(entry.sent, lastReply);
+            double response = elapsedMs(start, now);
+            Estimator &estimator = estimators[entry.request[0]];
+            if (estimator.rttVar < 0)
+            {
+                estimator.srtt   = response;
+                estimator.rttVar = response / 2;
+            }
+            else
+            {
+                estimator.rttVar = 0.75 * estimator.rttVar + 0.25 * std::fabs(estimator.srtt - response);
+                estimator.srtt   = 0.875 * estimator.srtt + 0.125 * response;
+            }
+            stats.lastResponse = response;
+            lastReply = now;
+
+            complete(entry, input.substr(0, entry.length), true);
+            input.erase(0, entry.length);
+            inFlight.pop_front();
+        }
+
+        if (inFlight.empty() && !input.empty())
+        {
+            stats.stale += input.size();
+            input.clear();
+        }
+
+        // A late reply would be taken for the next command, so everything in flight is dropped
+        // and replies arriving within another timeout are discarded before writing again
+        if (!inFlight.empty() && now >= inFlight.front().deadline)
+        {
+            resync = now + std::chrono::microseconds(static_cast<int64_t>(timeoutOf(inFlight.front()) * 1000));
+            for (auto &entry : inFlight)
+            {
+                stats.timeouts++;
+                complete(entry, std::string(), false);
+            }
+            inFlight.clear();
+            input.clear();
+            tcflush(fd, TCIFLUSH);
+        }
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ Starlight Xpress Active Optics command queue
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option)
+ any later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ The full GNU General Public License is included in this distribution in the
+ file called LICENSE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Command queue of the SX AO serial protocol.
+ *
+ * A worker thread writes the queued commands, up to depth of them ahead of
+ * their replies, and matches the replies in order as they arrive. Tilt (G) and
+ * mount guide (M) corrections which are still waiting to be sent are merged
+ * with newer corrections on the same axis, so a fast guide loop never builds
+ * up a backlog. Corrections larger than one command can carry are sent in
+ * parts and reported once. The timeout of each command follows the measured
+ * response time of its kind instead of a fixed window.
+ */
+class SXAOQueue
+{
+    public:
+        struct Result
+        {
+            int tag {0};            // tag passed with the command
+            std::string request;    // command as sent
+            std::string response;   // reply, empty if none arrived
+            bool ok {false};        // complete reply received
+            uint32_t merged {0};    // corrections merged into this command
+            double latency {0};     // ms from queueing the first correction to the reply
+        };
+
+        struct Statistics
+        {
+            uint32_t queued {0};    // commands and corrections queued
+            uint32_t sent {0};      // commands written
+            uint32_t merged {0};    // corrections merged into a queued one
+            uint32_t completed {0}; // commands answered
+            uint32_t timeouts {0};  // commands left without reply
+            uint32_t stale {0};     // bytes received with no command in flight
+            double lastLatency {0}; // ms
+            double maxLatency {0};  // ms
+            double lastResponse {0}; // ms from writing a command to its reply
+        };
+
+        SXAOQueue();
+        ~SXAOQueue();
+
+        /** Start the worker on fd. In simulation nothing is written and the worker answers the commands. */
+        bool start(int fd, bool simulation = false);
+        void stop();
+        bool isRunning() const
+        {
+            return running;
+        }
+
+        /** Commands written ahead of their replies, 1 waits for each reply before the next command */
+        void setDepth(int value);
+
+        /**
+         * @brief correction Queue tilt or mount guide correction.
+         * @param kind 'G' (tilt steps) or 'M' (guide pulse in 10 ms units)
+         * @param direction 'N', 'S', 'T' (east) or 'W'
+         * @param tag reported with the result, corrections are only merged with the same kind, axis and tag
+         */
+        void correction(char kind, char direction, int amount, int tag);
+
+        /** Queue command whose reply is length bytes, extra ms are added to its timeout */
+        void command(const char *request, size_t length, int tag, double extra = 0);
+
+        /** Queue command and wait for its reply, reply is NUL terminated and must hold length + 1 bytes */
+        bool transact(const char *request, char *reply, size_t length, double extra = 0);
+
+        /** Fetch the next result of command() and correction(), false if there is none */
+        bool takeResult(Result &result);
+
+        /** Nothing queued, in flight or left to fetch */
+        bool idle();
+
+        Statistics getStatistics();
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Entry
+        {
+            uint64_t id {0};
+            int tag {0};
+            char kind {0};          // G or M for corrections
+            char axis {0};          // N or T for corrections
+            int amount {0};         // signed, positive towards N or T
+            std::string request;
+            size_t length {1};
+            double extra {0};
+            uint32_t merged {0};
+            bool partial {false};   // the rest of the correction follows, its result reports both
+            bool failed {false};    // an earlier part of the correction failed
+            bool waited {false};    // result goes to transact()
+            Clock::time_point queued;
+            Clock::time_point sent;
+            Clock::time_point deadline;
+        };
+
+        // Response time estimator of one command kind, ms
+        struct Estimator
+        {
+            double srtt {0};
+            double rttVar { -1};
+        };
+
+        void run();
+        void enqueue(Entry &entry);
+        bool writeEntry(Entry &entry);
+        void complete(Entry &entry, const std::string &response, bool ok);
+        double timeoutOf(const Entry &entry);
+        std::string simulatedReply(const Entry &entry) const;
+
+        int fd {-1};
+        int wakeup[2] { -1, -1};
+        bool simulation {false};
+        std::atomic<bool> running {false};
+        size_t depth {1};
+        uint64_t nextID {1};
+
+        std::mutex lock;
+        std::condition_variable replied;
+        std::deque<Entry> pending;
+        std::deque<Entry> inFlight;
+        // An entry taken from pending is being written
+        bool writing {false};
+        std::deque<Result> results;
+        std::map<uint64_t, Result> waitedResults;
+        std::map<char, Estimator> estimators;
+        Clock::time_point lastReply;
+        // No command is written before, so that late replies to timed out commands are discarded
+        Clock::time_point resync;
+        Statistics stats;
+
+        std::thread worker;
+};
@@ -0,0 +1,320 @@
+/*
+ Starlight Xpress Active Optics command queue test
+
+ Runs the command queue of the AO driver against an emulated AO unit on a
+ pseudo terminal and reports the correction rate and latency it achieves.
+ Exits with a non-zero status if the mirror does not end up where the
+ corrections sent it, or if a command fails.
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or (at your option)
+ any later version.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ this program; if not, write to the Free Software Foundation, Inc., 59
+ Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+ The full GNU General Public License is included in this distribution in the
+ file called LICENSE.
+ */
+
+#include "sxaoqueue.h"
+
+#include "sxconfig.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Answers the SX AO commands like the real unit, taking baseUs plus stepUs per tilt step for each of them,
+// and keeps track of the tilt of the mirror
+class AOEmulator
+{
+    public:
+        AOEmulator(int baseUs, int stepUs) : baseUs(baseUs), stepUs(stepUs)
+        {
+            master = posix_openpt(O_RDWR | O_NOCTTY);
+            grantpt(master);
+            unlockpt(master);
+
+            slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+            struct termios tio;
+            tcgetattr(slave, &tio);
+            cfmakeraw(&tio);
+            tcsetattr(slave, TCSANOW, &tio);
+
+            worker = std::thread(&AOEmulator::run, this);
+        }
+
+        ~AOEmulator()
+        {
+            running = false;
+            worker.join();
+            close(slave);
+            close(master);
+        }
+
+        int fd() const
+        {
+            return slave;
+        }
+
+        /** Answer the next command usLate later than usual */
+        void delayNext(int usLate)
+        {
+            delayUs = usLate;
+        }
+
+        std::atomic<int> commands {0};
+        // Tilt steps towards north and east
+        std::atomic<long> north {0}, east {0};
+
+    private:
+        bool readByte(char &c)
+        {
+            while (running)
+            {
+                struct pollfd pfd = { master, POLLIN, 0 };
+                if (poll(&pfd, 1, 10) > 0 && read(master, &c, 1) == 1)
+                    return true;
+            }
+            return false;
+        }
+
+        void run()
+        {
+            char c;
+            while (readByte(c))
+            {
+                std::string reply;
+                int steps = 0;
+                if (c == 'G' || c == 'M')
+                {
+                    char argument[6] = {0};
+                    for (int i = 0; i < 6; i++)
+                        if (!readByte(argument[i]))
+                            return;
+                    if (c == 'G')
+                    {
+                        steps = atoi(argument + 1);
+                        switch (argument[0])
+                        {
+                            case 'N': north += steps; break;
+                            case 'S': north -= steps; break;
+                            case 'T': east += steps; break;
+                            case 'W': east -= steps; break;
+                        }
+                    }
+                    reply = std::string(1, c);
+                }
+                else if (c == 'X')
+                    reply = "Y";
+                else if (c == 'V')
+                    reply = "V112";
+                else if (c == 'L')
+                    reply = "@";
+                else
+                    reply = std::string(1, c);
+
+                commands++;
+                std::this_thread::sleep_for(std::chrono::microseconds(baseUs + steps * stepUs + delayUs.exchange(0)));
+                if (write(master, reply.data(), reply.size()) < 0)
+                    return;
+            }
+        }
+
+        int baseUs, stepUs;
+        int master {-1}, slave {-1};
+        std::atomic<int> delayUs {0};
+        std::atomic<bool> running {true};
+        std::thread worker;
+};
+
+// Wait until everything queued is answered, passing the results to handle
+template <typename Handler>
+static void drain(SXAOQueue &queue, Handler handle)
+{
+    SXAOQueue::Result result;
+    do
+    {
+        while (queue.takeResult(result))
+            handle(result);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    while (!queue.idle());
+}
+
+// Queue count corrections on alternating axes every periodUs and wait for all of them
+static bool measure(const char *title, int depth, int count, int periodUs)
+{
+    AOEmulator emulator(2000, 500);
+    SXAOQueue queue;
+    queue.setDepth(depth);
+    queue.start(emulator.fd());
+
+    char reply[8];
+    queue.transact("X", reply, 1);
+
+    auto start = std::chrono::steady_clock::now();
+    double sum = 0, worst = 0;
+    int results = 0, failures = 0;
+    long north = 0, east = 0;
+
+    auto handle = [&](const SXAOQueue::Result & result)
+    {
+        results++;
+        if (!result.ok || result.response != "G")
+            failures++;
+        sum  += result.latency;
+        worst = std::max(worst, result.latency);
+    };
+
+    for (int i = 0; i < count; i++)
+    {
+        // Mostly drift to the north east with some corrections back
+        static const char directions[] = { 'N', 'T', 'N', 'W', 'S', 'T' };
+        char direction = directions[i % 6];
+        int steps      = 1 + i % 3;
+        queue.correction('G', direction, steps, direction == 'N' || direction == 'S');
+        if (direction == 'N' || direction == 'S')
+            north += direction == 'N' ? steps : -steps;
+        else
+            east += direction == 'T' ? steps : -steps;
+
+        SXAOQueue::Result result;
+        while (queue.takeResult(result))
+            handle(result);
+        if (periodUs > 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(periodUs));
+    }
+    drain(queue, handle);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    SXAOQueue::Statistics stats = queue.getStatistics();
+    queue.stop();
+
+    printf("%-28s depth %d: %4d corrections in %.2f s, %4u sent (%.0f/s), %4u merged, latency mean %.1f ms max %.1f ms, %d failed\n",
+           title, depth, count, seconds, stats.sent - 1, (stats.sent - 1) / seconds, stats.merged,
+           results ? sum / results : 0, worst, failures);
+
+    if (emulator.north != north || emulator.east != east)
+    {
+        printf("FAILED: mirror at %ld N %ld E, corrections sum up to %ld N %ld E\n", emulator.north.load(), emulator.east.load(), north,
+               east);
+        return false;
+    }
+    return failures == 0;
+}
+
+// A correction beyond the range of one command is sent in parts and reported once
+static bool testSplit()
+{
+    AOEmulator emulator(1000, 0);
+    SXAOQueue queue;
+    queue.start(emulator.fd());
+
+    long steps = 2L * 99999 + 2;
+    queue.correction('G', 'S', steps, 0);
+
+    int results = 0;
+    bool ok = true;
+    std::string request;
+    drain(queue, [&](const SXAOQueue::Result & result)
+    {
+        results++;
+        ok = ok && result.ok;
+        request = result.request;
+    });
+    queue.stop();
+
+    if (results != 1 || !ok || emulator.commands != 3 || emulator.north != -steps)
+    {
+        printf("FAILED: %ld steps south took %d commands with %d results (%s), mirror at %ld N\n", steps, emulator.commands.load(), results,
+               ok ? "ok" : "failed", emulator.north.load());
+        return false;
+    }
+    printf("%-28s %ld steps in %d commands, last <%s>\n", "Split correction", steps, emulator.commands.load(), request.c_str());
+    return true;
+}
+
+// A reply arriving after its timeout must not be taken for the reply to the next command
+static bool testTimeout()
+{
+    AOEmulator emulator(2000, 0);
+    SXAOQueue queue;
+    queue.start(emulator.fd());
+
+    // Learn the response time of tilts, which brings their timeout down to its minimum
+    for (int i = 0; i < 4; i++)
+    {
+        queue.correction('G', 'N', 1, 0);
+        drain(queue, [](const SXAOQueue::Result &) {});
+    }
+
+    emulator.delayNext(400000);
+    queue.correction('G', 'T', 1, 0);
+    int timedOut = 0;
+    drain(queue, [&](const SXAOQueue::Result & result)
+    {
+        if (!result.ok)
+            timedOut++;
+    });
+
+    char reply[8];
+    bool identified = queue.transact("X", reply, 1) && strcmp(reply, "Y") == 0;
+
+    queue.correction('G', 'W', 1, 0);
+    int failures = 0;
+    drain(queue, [&](const SXAOQueue::Result & result)
+    {
+        if (!result.ok || result.response != "G")
+            failures++;
+    });
+
+    SXAOQueue::Statistics stats = queue.getStatistics();
+    queue.stop();
+
+    if (timedOut != 1 || stats.timeouts != 1 || !identified || failures != 0 || emulator.north != 4 || emulator.east != 0)
+    {
+        printf("FAILED: %d of %u commands timed out, reply to X <%s>, %d later corrections failed, mirror at %ld N %ld E\n", timedOut,
+               stats.timeouts, reply, failures, emulator.north.load(), emulator.east.load());
+        return false;
+    }
+    printf("%-28s late reply discarded, %u stale bytes\n", "Timeout", stats.stale);
+    return true;
+}
+
+int main()
+{
+    std::cout << "sx_ao_test version " << VERSION_MAJOR << "." << VERSION_MINOR << std::endl << std::endl;
+
+    bool ok = true;
+    for (int depth = 1; depth <= 2; depth++)
+    {
+        ok = measure("50 Hz corrections", depth, 100, 20000) && ok;
+        ok = measure("200 Hz corrections", depth, 400, 5000) && ok;
+        ok = measure("500 Hz corrections", depth, 1000, 2000) && ok;
+        ok = measure("Back to back corrections", depth, 1000, 0) && ok;
+    }
+    ok = testSplit() && ok;
+    ok = testTimeout() && ok;
+
+    return ok ? 0 : 1;
+}
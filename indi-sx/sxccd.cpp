@@ -49,6 +49,8 @@ static SXCCD *cameras[20];
 
 #define TIMER 1000
 
+#define GUIDE_CENTROID_TAB "Guide Centroid"
+
 static void cleanup()
 {
     for (int i = 0; i < count; i++)
@@ -251,6 +253,9 @@ bool SXCCD::initProperties()
     //                       60, IPS_IDLE);
     IUSaveText(&BayerT[2], "RGGB");
 
+    //  guide head can publish the star centroid instead of sending every frame
+    GuideCentroidProperties.init(getDeviceName(), "GUIDER", GUIDE_CENTROID_TAB);
+
     //  we can expose less than 0.01 seconds at a time
     //  and we need to for an allsky in daytime
     PrimaryCCD.setMinMaxStep("CCD_EXPOSURE", "CCD_EXPOSURE_VALUE", 0.0001, 3600, 0.0001, false);
@@ -268,6 +273,8 @@ bool SXCCD::updateProperties()
             defineProperty(&CoolerSP);
         if (HasShutter)
             defineProperty(&ShutterSP);
+        if (HasGuideHead)
+            GuideCentroidProperties.define(this);
         //        if (HasColor) {
         //            defineProperty(&BayerSP);
         //        }
@@ -278,6 +285,8 @@ bool SXCCD::updateProperties()
             deleteProperty(CoolerSP.name);
         if (HasShutter)
             deleteProperty(ShutterSP.name);
+        if (HasGuideHead)
+            GuideCentroidProperties.remove(this);
         //        if (HasColor) {
         //            deleteProperty(BayerSP.name);
         //        }
@@ -718,7 +727,17 @@ void SXCCD::GuideExposureTimerHit()
         InGuideExposure = false;
         GuideCCD.setExposureLeft(GuideExposureTimeLeft = 0);
         if (rc)
-            ExposureComplete(&GuideCCD);
+        {
+            GuideCentroid::Frame star = { buf, (uint32_t)(subW / binX), (uint32_t)(subH / binY),
+                                          (uint8_t)GuideCCD.getBPP(), 1, false };
+            if (GuideCentroidProperties.isEnabled() && !GuideCentroidProperties.update(star))
+            {
+                //  centroid only, the frame is not sent
+                GuideCentroid::completeExposure(this, &GuideCCD, "GUIDER_EXPOSURE");
+            }
+            else
+                ExposureComplete(&GuideCCD);
+        }
     }
 }
 
@@ -870,6 +889,12 @@ bool SXCCD::ISNewSwitch(const char *dev, const char *name, ISState *states, char
         IDSetNumber(&TemperatureNP, nullptr);
         result = true;
     }
+    else if (dev != nullptr && strcmp(dev, getDeviceName()) == 0 &&
+             GuideCentroidProperties.processSwitch(name, states, names, n))
+    {
+        //  full frame request is served and reset with the next guide frame
+        result = true;
+    }
     //    else if (strcmp(name, BayerSP.name) == 0)
     //    {
     //        IUUpdateSwitch(&BayerSP, states, names, n);
@@ -890,9 +915,19 @@ bool SXCCD::ISNewSwitch(const char *dev, const char *name, ISState *states, char
     return result;
 }
 
-//bool SXCCD::saveConfigItems(FILE *fp)
-//{
-//    INDI::CCD::saveConfigItems(fp);
-//    IUSaveConfigSwitch(fp, &BayerSP);
-//    return true;
-//}
+bool SXCCD::ISNewNumber(const char *dev, const char *name, double values[], char *names[], int n)
+{
+    if (dev != nullptr && strcmp(dev, getDeviceName()) == 0 &&
+            GuideCentroidProperties.processNumber(name, values, names, n))
+        return true;
+    return INDI::CCD::ISNewNumber(dev, name, values, names, n);
+}
+
+bool SXCCD::saveConfigItems(FILE *fp)
+{
+    INDI::CCD::saveConfigItems(fp);
+    //    IUSaveConfigSwitch(fp, &BayerSP);
+    if (HasGuideHead)
+        GuideCentroidProperties.save(fp);
+    return true;
+}
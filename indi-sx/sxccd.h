@@ -32,6 +32,7 @@
 #pragma once
 
 #include "sxccdusb.h"
+#include "guide_centroid_properties.h"
 
 #include <indiccd.h>
 
@@ -55,6 +56,7 @@ class SXCCD : public INDI::CCD
         ISwitchVectorProperty ShutterSP;
         //    ISwitch BayerS[2];
         //    ISwitchVectorProperty BayerSP;
+        GuideCentroid::Properties GuideCentroidProperties;
         float TemperatureRequest;
         float TemperatureReported;
         float ExposureTimeLeft;
@@ -88,7 +90,7 @@ class SXCCD : public INDI::CCD
         void GuideExposureTimerHit();
         void WEGuiderTimerHit();
         void NSGuiderTimerHit();
-        //bool saveConfigItems(FILE *fp);
+        bool saveConfigItems(FILE *fp);
         IPState GuideWest(uint32_t ms);
         IPState GuideEast(uint32_t ms);
         IPState GuideNorth(uint32_t ms);
@@ -106,6 +108,7 @@ class SXCCD : public INDI::CCD
         void simulationTriggered(bool enable);
         void ISGetProperties(const char *dev);
         bool ISNewSwitch(const char *dev, const char *name, ISState *states, char *names[], int n);
+        bool ISNewNumber(const char *dev, const char *name, double values[], char *names[], int n);
 
         friend void ::ExposureTimerCallback(void *p);
         friend void ::GuideExposureTimerCallback(void *p);
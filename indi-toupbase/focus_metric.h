@@ -0,0 +1,224 @@
+/*
+    Focus metrics computed on streamed frames
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace FocusMetric
+{
+
+enum Method
+{
+    METHOD_OFF,
+    METHOD_LAPLACIAN,
+    METHOD_BRENNER,
+    METHOD_HFR
+};
+
+/** Frame as delivered by the camera, sizes in (binned) pixels */
+struct Frame
+{
+    const uint8_t *data;
+    uint32_t width;
+    uint32_t height;
+    uint8_t bpp;        // 8 or 16
+    uint8_t channels;   // 1 for mono/raw, 3 for interleaved RGB (green is used)
+    uint8_t step;       // distance to the nearest same-colour neighbour, 2 for raw bayer
+};
+
+/** Region of interest, w or h equal to zero selects the whole frame */
+struct ROI
+{
+    uint32_t x, y, w, h;
+};
+
+namespace Detail
+{
+
+// The inner loops below work on a single row with plain contiguous indexing,
+// so that the compiler can vectorize them.
+
+template <typename T>
+double laplacianVariance(const T *img, uint32_t width, uint32_t channels, uint32_t s,
+                         uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+{
+    const size_t stride = size_t(width) * channels;
+    const size_t ds     = size_t(s) * channels;
+    double sum = 0, sumSq = 0;
+    size_t count = 0;
+
+    for (uint32_t y = y0 + s; y + s < y1; ++y)
+    {
+        const T *up   = img + (y - s) * stride;
+        const T *row  = img + y * stride;
+        const T *down = img + (y + s) * stride;
+        double rowSum = 0, rowSumSq = 0;
+
+        for (size_t i = size_t(x0 + s) * channels; i < size_t(x1 - s) * channels; i += channels)
+        {
+            int32_t l = 4 * int32_t(row[i]) - row[i - ds] - row[i + ds] - up[i] - down[i];
+            rowSum   += l;
+            rowSumSq += double(l) * l;
+        }
+        sum   += rowSum;
+        sumSq += rowSumSq;
+        count += (x1 - x0 - 2 * s);
+    }
+
+    if (count == 0)
+        return 0;
+
+    double mean = sum / count;
+    return sumSq / count - mean * mean;
+}
+
+template <typename T>
+double brennerGradient(const T *img, uint32_t width, uint32_t channels, uint32_t s,
+                       uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+{
+    const size_t stride = size_t(width) * channels;
+    const size_t ds     = size_t(2 * s) * channels;
+    double sum = 0;
+    size_t count = 0;
+
+    for (uint32_t y = y0; y < y1; ++y)
+    {
+        const T *row = img + y * stride;
+        double rowSum = 0;
+
+        for (size_t i = size_t(x0) * channels; i + ds < size_t(x1) * channels; i += channels)
+        {
+            int32_t d = int32_t(row[i + ds]) - row[i];
+            rowSum += double(d) * d;
+        }
+        sum   += rowSum;
+        count += (x1 - x0 > 2 * s) ? x1 - x0 - 2 * s : 0;
+    }
+
+    return count ? sum / count : 0;
+}
+
+template <typename T>
+double halfFluxRadius(const T *img, uint32_t width, uint32_t channels,
+                      uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+{
+    const size_t stride = size_t(width) * channels;
+
+    // Background from the ROI border, which is assumed to be free of the star
+    double border = 0;
+    size_t borderCount = 0;
+    for (uint32_t x = x0; x < x1; ++x)
+    {
+        border += img[y0 * stride + x * channels];
+        border += img[(y1 - 1) * stride + x * channels];
+        borderCount += 2;
+    }
+    for (uint32_t y = y0 + 1; y + 1 < y1; ++y)
+    {
+        border += img[y * stride + x0 * channels];
+        border += img[y * stride + (x1 - 1) * channels];
+        borderCount += 2;
+    }
+    const double background = borderCount ? border / borderCount : 0;
+
+    // Flux weighted centroid
+    double flux = 0, cx = 0, cy = 0;
+    for (uint32_t y = y0; y < y1; ++y)
+    {
+        const T *row = img + y * stride;
+        for (uint32_t x = x0; x < x1; ++x)
+        {
+            double v = row[x * channels] - background;
+            if (v <= 0)
+                continue;
+            flux += v;
+            cx   += v * x;
+            cy   += v * y;
+        }
+    }
+
+    if (flux <= 0)
+        return 0;
+
+    cx /= flux;
+    cy /= flux;
+
+    double radius = 0;
+    for (uint32_t y = y0; y < y1; ++y)
+    {
+        const T *row = img + y * stride;
+        for (uint32_t x = x0; x < x1; ++x)
+        {
+            double v = row[x * channels] - background;
+            if (v <= 0)
+                continue;
+            radius += v * std::sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy));
+        }
+    }
+
+    return radius / flux;
+}
+
+template <typename T>
+double compute(Method method, const Frame &frame, const ROI &roi)
+{
+    uint32_t x0 = std::min(roi.x, frame.width);
+    uint32_t y0 = std::min(roi.y, frame.height);
+    uint32_t x1 = (roi.w == 0) ? frame.width  : std::min(roi.x + roi.w, frame.width);
+    uint32_t y1 = (roi.h == 0) ? frame.height : std::min(roi.y + roi.h, frame.height);
+    uint32_t s  = std::max<uint32_t>(frame.step, 1);
+
+    if (x1 <= x0 + 2 * s || y1 <= y0 + 2 * s)
+        return 0;
+
+    // For interleaved RGB the green channel is used
+    const T *img = reinterpret_cast<const T *>(frame.data) + (frame.channels == 3 ? 1 : 0);
+
+    switch (method)
+    {
+        case METHOD_LAPLACIAN:
+            return laplacianVariance(img, frame.width, frame.channels, s, x0, y0, x1, y1);
+        case METHOD_BRENNER:
+            return brennerGradient(img, frame.width, frame.channels, s, x0, y0, x1, y1);
+        case METHOD_HFR:
+            return halfFluxRadius(img, frame.width, frame.channels, x0, y0, x1, y1);
+        default:
+            return 0;
+    }
+}
+
+}
+
+/**
+ * @brief compute Calculate focus metric of the frame within the region of interest.
+ * @return Laplacian variance or Brenner gradient (higher is sharper) or half flux radius in pixels (lower is sharper).
+ */
+inline double compute(Method method, const Frame &frame, const ROI &roi)
+{
+    if (frame.data == nullptr || method == METHOD_OFF)
+        return 0;
+
+    return frame.bpp > 8
+           ? Detail::compute<uint16_t>(method, frame, roi)
+           : Detail::compute<uint8_t>(method, frame, roi);
+}
+
+}
@@ -36,6 +36,7 @@
 
 #define CONTROL_TAB "Controls"
 #define LEVEL_TAB "Levels"
+#define FOCUS_METRIC_TAB "Focus Metric"
 
 #ifndef MAKEFOURCC
 #define MAKEFOURCC(ch0, ch1, ch2, ch3) \
@@ -417,6 +418,28 @@ bool ToupBase::initProperties()
     IUFillText(&SDKVersionT[0], "VERSION", "Version", nullptr);
     IUFillTextVector(&SDKVersionTP, SDKVersionT, 1, getDeviceName(), "SDK", "SDK", "Firmware", IP_RO, 0, IPS_IDLE);
 
+    ///////////////////////////////////////////////////////////////////////////////////
+    /// Focus Metric
+    ///////////////////////////////////////////////////////////////////////////////////
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_OFF], "FOCUS_METRIC_OFF", "Off", ISS_ON);
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_LAPLACIAN], "FOCUS_METRIC_LAPLACIAN", "Laplacian variance", ISS_OFF);
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_BRENNER], "FOCUS_METRIC_BRENNER", "Brenner gradient", ISS_OFF);
+    IUFillSwitch(&FocusMetricS[FocusMetric::METHOD_HFR], "FOCUS_METRIC_HFR", "HFR", ISS_OFF);
+    IUFillSwitchVector(&FocusMetricSP, FocusMetricS, 4, getDeviceName(), "CCD_FOCUS_METRIC_MODE", "Metric", FOCUS_METRIC_TAB,
+                       IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+
+    /// ROI in streamed frame pixels, zero width or height selects the whole frame
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_X], "X", "Left", "%.f", 0, 16000, 1, 0);
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_Y], "Y", "Top", "%.f", 0, 16000, 1, 0);
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_W], "WIDTH", "Width", "%.f", 0, 16000, 1, 0);
+    IUFillNumber(&FocusMetricROIN[FOCUS_ROI_H], "HEIGHT", "Height", "%.f", 0, 16000, 1, 0);
+    IUFillNumberVector(&FocusMetricROINP, FocusMetricROIN, 4, getDeviceName(), "CCD_FOCUS_METRIC_ROI", "ROI",
+                       FOCUS_METRIC_TAB, IP_RW, 60, IPS_IDLE);
+
+    IUFillNumber(&FocusMetricN[0], "FOCUS_METRIC_VALUE", "Value", "%.3f", 0, 1e12, 0, 0);
+    IUFillNumberVector(&FocusMetricNP, FocusMetricN, 1, getDeviceName(), "CCD_FOCUS_METRIC", "Focus Metric",
+                       FOCUS_METRIC_TAB, IP_RO, 60, IPS_IDLE);
+
     PrimaryCCD.setMinMaxStep("CCD_BINNING", "HOR_BIN", 1, 4, 1, false);
     PrimaryCCD.setMinMaxStep("CCD_BINNING", "VER_BIN", 1, 4, 1, false);
 
@@ -485,6 +508,11 @@ bool ToupBase::updateProperties()
             defineProperty(&WBRGBNP);
         }
 
+        // Focus Metric
+        defineProperty(&FocusMetricSP);
+        defineProperty(&FocusMetricROINP);
+        defineProperty(&FocusMetricNP);
+
         // Firmware
         defineProperty(&FirmwareTP);
         defineProperty(&SDKVersionTP);
@@ -532,6 +560,10 @@ bool ToupBase::updateProperties()
             deleteProperty(WBRGBNP.name);
         }
 
+        deleteProperty(FocusMetricSP.name);
+        deleteProperty(FocusMetricROINP.name);
+        deleteProperty(FocusMetricNP.name);
+
         deleteProperty(FirmwareTP.name);
         deleteProperty(SDKVersionTP.name);
     }
@@ -1335,6 +1367,17 @@ bool ToupBase::ISNewNumber(const char *dev, const char *name, double values[], c
             return true;
         }
 
+        //////////////////////////////////////////////////////////////////////
+        /// Focus Metric ROI
+        //////////////////////////////////////////////////////////////////////
+        if (!strcmp(name, FocusMetricROINP.name))
+        {
+            IUUpdateNumber(&FocusMetricROINP, values, names, n);
+            FocusMetricROINP.s = IPS_OK;
+            IDSetNumber(&FocusMetricROINP, nullptr);
+            return true;
+        }
+
     }
 
     return INDI::CCD::ISNewNumber(dev, name, values, names, n);
@@ -1790,6 +1833,17 @@ bool ToupBase::ISNewSwitch(const char *dev, const char *name, ISState * states,
             IDSetSwitch(&WBAutoSP, nullptr);
             return true;
         }
+
+        //////////////////////////////////////////////////////////////////////
+        /// Focus Metric
+        //////////////////////////////////////////////////////////////////////
+        if (!strcmp(name, FocusMetricSP.name))
+        {
+            IUUpdateSwitch(&FocusMetricSP, states, names, n);
+            FocusMetricSP.s = IPS_OK;
+            IDSetSwitch(&FocusMetricSP, nullptr);
+            return true;
+        }
     }
 
     return INDI::CCD::ISNewSwitch(dev, name, states, names, n);
@@ -2373,6 +2427,9 @@ bool ToupBase::saveConfigItems(FILE * fp)
     IUSaveConfigSwitch(fp, &VideoFormatSP);
     if (m_HasLowNoise)
         IUSaveConfigSwitch(fp, &LowNoiseSP);
+
+    IUSaveConfigSwitch(fp, &FocusMetricSP);
+    IUSaveConfigNumber(fp, &FocusMetricROINP);
     return true;
 }
 
@@ -2441,6 +2498,7 @@ void ToupBase::pushCallback(const void* pData, const XP(FrameInfoV2)* pInfo, int
         //HRESULT rc = FP(PullImageV2(m_CameraHandle, PrimaryCCD.getFrameBuffer(), captureBits * m_Channels, &info));
         //guard.unlock();
         //if (rc >= 0)
+        updateFocusMetric(reinterpret_cast<const uint8_t*>(pData));
         Streamer->newFrame(reinterpret_cast<const uint8_t*>(pData), PrimaryCCD.getFrameBufferSize());
     }
     else if (InExposure)
@@ -2504,6 +2562,33 @@ void ToupBase::pushCallback(const void* pData, const XP(FrameInfoV2)* pInfo, int
     }
 }
 
+void ToupBase::updateFocusMetric(const uint8_t *frame)
+{
+    int method = IUFindOnSwitchIndex(&FocusMetricSP);
+    if (frame == nullptr || method <= FocusMetric::METHOD_OFF)
+        return;
+
+    FocusMetric::Frame image;
+    image.data     = frame;
+    image.width    = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
+    image.height   = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
+    image.bpp      = m_BitsPerPixel;
+    image.channels = m_Channels;
+    // Raw bayer frames are measured on same-colour neighbours only
+    image.step     = (m_MonoCamera == false && m_CurrentVideoFormat == TC_VIDEO_COLOR_RAW) ? 2 : 1;
+
+    FocusMetric::ROI roi;
+    roi.x = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_X].value);
+    roi.y = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_Y].value);
+    roi.w = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_W].value);
+    roi.h = static_cast<uint32_t>(FocusMetricROIN[FOCUS_ROI_H].value);
+
+    // Published for every frame, while preview frames are throttled by the stream manager
+    FocusMetricN[0].value = FocusMetric::compute(static_cast<FocusMetric::Method>(method), image, roi);
+    FocusMetricNP.s = IPS_OK;
+    IDSetNumber(&FocusMetricNP, nullptr);
+}
+
 void ToupBase::eventCB(unsigned event, void* pCtx)
 {
     static_cast<ToupBase*>(pCtx)->eventPullCallBack(event);
@@ -2535,7 +2620,10 @@ void ToupBase::eventPullCallBack(unsigned event)
                     HRESULT rc = FP(PullImageV2(m_CameraHandle, PrimaryCCD.getFrameBuffer(), captureBits * m_Channels, &info));
                     guard.unlock();
                     if (SUCCEEDED(rc))
+                    {
+                        updateFocusMetric(PrimaryCCD.getFrameBuffer());
                         Streamer->newFrame(PrimaryCCD.getFrameBuffer(), PrimaryCCD.getFrameBufferSize());
+                    }
                 }
                 else if (InExposure)
                 {
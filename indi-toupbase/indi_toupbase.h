@@ -24,6 +24,8 @@
 #include <map>
 #include <indiccd.h>
 
+#include "focus_metric.h"
+
 #ifdef BUILD_TOUPCAM
 #include <toupcam.h>
 #define FP(x) Toupcam_##x
@@ -355,6 +357,8 @@ class ToupBase : public INDI::CCD
         // Video Format & Streaming
         //#############################################################################
         void getVideoImage();
+        // Compute and publish focus metric of the streamed frame
+        void updateFocusMetric(const uint8_t *frame);
 
         //#############################################################################
         // Guiding
@@ -625,6 +629,23 @@ class ToupBase : public INDI::CCD
             GAIN_HDR
         };
 
+        // Focus Metric computed on streamed frames
+        ISwitchVectorProperty FocusMetricSP;
+        ISwitch FocusMetricS[4];
+
+        INumberVectorProperty FocusMetricROINP;
+        INumber FocusMetricROIN[4];
+        enum
+        {
+            FOCUS_ROI_X,
+            FOCUS_ROI_Y,
+            FOCUS_ROI_W,
+            FOCUS_ROI_H
+        };
+
+        INumberVectorProperty FocusMetricNP;
+        INumber FocusMetricN[1];
+
         uint8_t m_CurrentVideoFormat = TC_VIDEO_COLOR_RGB;
         INDI_PIXEL_FORMAT m_CameraPixelFormat = INDI_RGB;
         eTriggerMode m_CurrentTriggerMode = TRIGGER_VIDEO;
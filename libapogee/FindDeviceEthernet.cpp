@@ -17,6 +17,8 @@
 #include "helpers.h"
 #include "CameraInfo.h" 
 
+#include <map>
+#include <mutex>
 #include <sstream>
 
 #if defined (WIN_OS)
@@ -29,6 +31,10 @@
 namespace
 {
     const uint16_t APOGEE_IP_PORT_NUMBER = 2571;
+
+    //results of the searches done by this process, by subnet
+    std::map<std::string, std::string> searchCache;
+    std::mutex searchCacheMutex;
 }
 
 //////////////////////////// 
@@ -70,6 +76,44 @@ int32_t FindDeviceEthernet::GetTimeout()
     return m_socketPtr->GetTimeout();
 }
 
+//////////////////////////// 
+// SET      EXPECTED        DEVICES
+void FindDeviceEthernet::SetExpectedDevices(const int32_t count)
+{
+    m_socketPtr->SetExpectedReplies( count );
+}
+
+//////////////////////////// 
+// SET      QUIET       PERIOD
+void FindDeviceEthernet::SetQuietPeriod(const int32_t msec)
+{
+    m_socketPtr->SetQuietPeriod( msec );
+}
+
+//////////////////////////// 
+// CLEAR    CACHE
+void FindDeviceEthernet::ClearCache()
+{
+    std::lock_guard<std::mutex> lock( searchCacheMutex );
+    searchCache.clear();
+}
+
+//////////////////////////// 
+// FIND     CACHED
+std::string FindDeviceEthernet::FindCached(const std::string & subnet)
+{
+    {
+        std::lock_guard<std::mutex> lock( searchCacheMutex );
+        std::map<std::string, std::string>::const_iterator cached = searchCache.find( subnet );
+        if( cached != searchCache.end() )
+        {
+            return cached->second;
+        }
+    }
+
+    return Find( subnet );
+}
+
 //////////////////////////// 
 // FIND 
 std::string FindDeviceEthernet::Find(const std::string & subnet)
@@ -117,6 +161,9 @@ std::string FindDeviceEthernet::Find(const std::string & subnet)
         return noop;
     }
 
+    std::lock_guard<std::mutex> lock( searchCacheMutex );
+    searchCache[subnet] = devices;
+
     return devices;
 }
 
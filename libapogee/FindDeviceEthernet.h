@@ -42,6 +42,32 @@ class DLL_EXPORT FindDeviceEthernet
          */
         std::string Find(const std::string & subnet);
 
+        /*! 
+         * Return the result of an earlier successful search of this subnet, if
+         * there is one, instead of searching again.
+         * \param [in]  subnet Subnet address to search, 192.168.0.255 for example.
+         * \return Same format as Find()
+         */
+        std::string FindCached(const std::string & subnet);
+
+        /*! 
+         * Forget the results of earlier searches, e.g. after a device was not
+         * found at the cached address.
+         */
+        static void ClearCache();
+
+        /*! 
+         * Stop the search as soon as this many devices answered
+         * \param [in]  count Number of devices, 0 to wait for the timeout or the quiet period
+         */
+        void SetExpectedDevices(int32_t count);
+
+        /*! 
+         * Stop the search when no device answered for this long, after the first answer
+         * \param [in]  msec Quiet period in msec, 0 to wait for the timeout or the expected devices
+         */
+        void SetQuietPeriod(int32_t msec);
+
          /*! 
          * Returns The number of seconds the search has taken
          */
@@ -12,6 +12,8 @@
 #include "UdpSocketBase.h" 
 #include "apgHelper.h" 
 #include <sstream>
+#include <algorithm>
+#include <chrono>
 #include <cstring> //for memset
 
 #if defined (WIN_OS)
@@ -39,7 +41,9 @@ UdpSocketBase::UdpSocketBase() : m_SocketDescriptor(INVALID_SOCKET),
                                  m_udpPacket(""),
                                  m_fileName(__FILE__),
                                  m_timeout(DISCOVERY_TIMEOUT_SECS),
-                                 m_elapsedSec(0)
+                                 m_elapsedSec(0),
+                                 m_expectedReplies(0),
+                                 m_quietMsec(0)
 
 { 
     
@@ -202,51 +206,98 @@ void UdpSocketBase::BroadcastMsg(const std::string & subnet,
     }
 }
 
+//////////////////////////// 
+//  IS      MSG     PENDING
+bool UdpSocketBase::IsMsgPending(const int32_t waitMsec)
+{
+    struct timeval tv;
+    fd_set rset;
+
+    FD_ZERO( &rset );
+    FD_SET( m_SocketDescriptor, &rset );
+
+    tv.tv_sec = waitMsec / 1000;
+    tv.tv_usec = (waitMsec % 1000) * 1000;
+
+    int32_t result = select( m_SocketDescriptor + 1, &rset, 0, 0, &tv );
+
+    if( SOCKET_ERROR == result ) 
+    {
+        std::stringstream ss;
+        ss << result;
+
+        std::string errMsg = "select failed with error " + ss.str();
+        apgHelper::throwRuntimeException(m_fileName, errMsg, 
+            __LINE__, Apg::ErrorType_Connection);
+    }
+
+    // return of 0 = time limit expired
+    // return of > 0 total number of socket handles 
+    // that are ready and contained in fd_set
+    return result > 0;
+}
+
 //////////////////////////// 
 //  RECEIVED        MSG
 std::vector<std::string> UdpSocketBase::GetReturnedMsgs()
 {
-
-    struct timeval tv;
-	fd_set rset;
+    typedef std::chrono::steady_clock Clock;
 
     std::vector<std::string> returnedStrs;
+    int32_t replies = 0;
+
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point deadline = start + std::chrono::seconds( m_timeout );
+    Clock::time_point lastReply = start;
 
     //wait for responses
-    for(m_elapsedSec = 0; m_elapsedSec < m_timeout; ++m_elapsedSec)
-   {
-        FD_ZERO( &rset );
-		FD_SET( m_SocketDescriptor, &rset );
-
-		//LT: putting this here, because it appears that
-		//the structure is getting set to zero after the first
-		//read on linux
-		tv.tv_sec = 1;
-		tv.tv_usec = 0;
-
-        int32_t result = select( m_SocketDescriptor + 1, &rset, 0, 0, &tv );
-        
-    	if( SOCKET_ERROR == result ) 
-		{
-           std::stringstream ss;
-           ss << result;
-		
-            std::string errMsg = "select failed with error " + ss.str();
-            apgHelper::throwRuntimeException(m_fileName, errMsg, 
-                __LINE__, Apg::ErrorType_Connection);
+    while( true )
+    {
+        Clock::time_point now = Clock::now();
+        Clock::time_point until = deadline;
+        if( m_quietMsec > 0 && replies > 0 )
+        {
+            until = std::min( until, lastReply + std::chrono::milliseconds( m_quietMsec ) );
         }
 
-        // return of 0 = time limit expired
-        // return of > 0 total number of socket handles 
-        // that are ready and contained in fd_set
-        // there is data so lets go fectch it
-        if( result > 0 )
+        if( now >= until )
         {
-            returnedStrs.push_back( FetchMsgFromSocket() );
+            break;
         }
 
+        const int32_t waitMsec = static_cast<int32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>( until - now ).count() ) + 1;
+
+        if( !IsMsgPending( waitMsec ) )
+        {
+            continue;
+        }
+
+        //several devices may have answered within the same wait,
+        //so fetch every datagram that is queued before waiting again
+        do
+        {
+            std::string msg = FetchMsgFromSocket();
+
+            //the socket also receives our own broadcast
+            if( msg != m_udpPacket )
+            {
+                ++replies;
+                lastReply = Clock::now();
+            }
+            returnedStrs.push_back( msg );
+        }
+        while( IsMsgPending( 0 ) );
+
+        if( m_expectedReplies > 0 && replies >= m_expectedReplies )
+        {
+            break;
+        }
     }
 
+    m_elapsedSec = static_cast<int32_t>(
+        std::chrono::duration_cast<std::chrono::seconds>( Clock::now() - start ).count() );
+
     return returnedStrs;
 }
 
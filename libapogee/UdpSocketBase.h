@@ -28,6 +28,11 @@ class UdpSocketBase
         int32_t GetElapsedSecs() { return m_elapsedSec;}
         int32_t GetTimeout() {return m_timeout;}
 
+        // Stop collecting replies once this many devices answered, 0 waits for the timeout
+        void SetExpectedReplies(int32_t count) { m_expectedReplies = count; }
+        // Stop collecting replies after this many msec without one, 0 waits for the timeout
+        void SetQuietPeriod(int32_t msec) { m_quietMsec = msec; }
+
     protected:
         UdpSocketBase();
         virtual void CloseSocket() = 0;
@@ -42,6 +47,7 @@ class UdpSocketBase
             uint16_t portNum);
 
         std::string FetchMsgFromSocket();
+        bool IsMsgPending(int32_t waitMsec);
         std::vector<std::string> GetReturnedMsgs();
 
         
@@ -49,6 +55,8 @@ class UdpSocketBase
         const std::string m_fileName;
         int32_t m_timeout;
         int32_t m_elapsedSec;
+        int32_t m_expectedReplies;
+        int32_t m_quietMsec;
 
         //disabling the copy ctor and assignment operator
         //generated by the compiler - don't want them